@@ -0,0 +1,660 @@
+#include <Wire/Wire.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <algorithm>
+#include <filesystem>
+#include <memory_resource>
+#include <optional>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	SERIALIZE_COMPONENT(struct BenchPosition
+	{
+		CREATE_COMPONENT_GUID("{5A1C8F7E-3B2D-4E61-9C0A-7D4F2B8E1A35}"_guid);
+		float x;
+		float y;
+		float z;
+	}, BenchPosition);
+
+	SERIALIZE_COMPONENT(struct BenchVelocity
+	{
+		CREATE_COMPONENT_GUID("{C2E9B4D1-6A7F-4F38-8B15-0E3D9A6C4F72}"_guid);
+		float x;
+		float y;
+		float z;
+	}, BenchVelocity);
+
+	SERIALIZE_COMPONENT(struct BenchMass
+	{
+		CREATE_COMPONENT_GUID("{1F6D3A90-7C2E-4B58-9E41-D8A05B3C6F17}"_guid);
+		float mass;
+	}, BenchMass);
+
+	SERIALIZE_COMPONENT(struct BenchParticle
+	{
+		CREATE_COMPONENT_GUID("{8E4A2C61-0F5B-47D9-A3E8-6B1C9D2F7E40}"_guid);
+		float positionX;
+		float positionY;
+		float positionZ;
+		float velocityX;
+		float velocityY;
+		float velocityZ;
+		float red;
+		float green;
+		float blue;
+		float alpha;
+		float size;
+		float rotation;
+		float lifetime;
+		float age;
+	}, BenchParticle);
+
+	using Clock = std::chrono::high_resolution_clock;
+
+	template<typename F>
+	double MeasureMilliseconds(uint32_t aIterations, F&& func)
+	{
+		const auto start = Clock::now();
+		for (uint32_t i = 0; i < aIterations; i++)
+		{
+			func();
+		}
+
+		return std::chrono::duration<double, std::milli>(Clock::now() - start).count() / aIterations;
+	}
+
+	// Prints the cost of one operation and the throughput, aMilliseconds is the time aOperations took
+	void Report(const char* aName, uint32_t aEntityCount, uint64_t aOperations, double aMilliseconds)
+	{
+		const double nanosecondsPerOperation = aMilliseconds * 1e6 / (double)aOperations;
+		const double millionsPerSecond = (double)aOperations / (aMilliseconds * 1e3);
+
+		printf("%-36s %8u entities: %9.2f ns/op %9.2f Mop/s\n", aName, aEntityCount, nanosecondsPerOperation, millionsPerSecond);
+	}
+
+	void BenchmarkEntityLifetime(uint32_t aEntityCount)
+	{
+		constexpr uint32_t iterations = 5;
+		std::vector<Wire::EntityId> entities(aEntityCount);
+
+		double create = 0.0;
+		double destroy = 0.0;
+
+		// The second pass reuses the slots freed by the first one
+		for (uint32_t iteration = 0; iteration < iterations; iteration++)
+		{
+			Wire::Registry registry;
+			for (uint32_t pass = 0; pass < 2; pass++)
+			{
+				create += MeasureMilliseconds(1, [&]()
+					{
+						for (Wire::EntityId& entity : entities)
+						{
+							entity = registry.CreateEntity();
+						}
+					});
+
+				registry.AddComponents<BenchPosition>(entities, BenchPosition{ 0.f, 0.f, 0.f });
+
+				destroy += MeasureMilliseconds(1, [&]()
+					{
+						for (const Wire::EntityId entity : entities)
+						{
+							registry.RemoveEntity(entity);
+						}
+					});
+			}
+		}
+
+		Report("CreateEntity", aEntityCount, (uint64_t)aEntityCount * iterations * 2, create);
+		Report("RemoveEntity (1 component)", aEntityCount, (uint64_t)aEntityCount * iterations * 2, destroy);
+	}
+
+	void BenchmarkComponentChurn(uint32_t aEntityCount)
+	{
+		constexpr uint32_t iterations = 5;
+
+		Wire::Registry registry;
+		std::vector<Wire::EntityId> entities(aEntityCount);
+		registry.CreateEntities(aEntityCount, entities);
+		registry.AddComponents<BenchPosition>(entities, BenchPosition{ 0.f, 0.f, 0.f });
+
+		double add = 0.0;
+		double remove = 0.0;
+
+		for (uint32_t iteration = 0; iteration < iterations; iteration++)
+		{
+			add += MeasureMilliseconds(1, [&]()
+				{
+					for (const Wire::EntityId entity : entities)
+					{
+						registry.AddComponent<BenchVelocity>(entity, 1.f, 0.f, 0.f);
+					}
+				});
+
+			// Removing in creation order moves a different component into every hole
+			remove += MeasureMilliseconds(1, [&]()
+				{
+					for (const Wire::EntityId entity : entities)
+					{
+						registry.RemoveComponent<BenchVelocity>(entity);
+					}
+				});
+		}
+
+		Report("AddComponent<Velocity>", aEntityCount, (uint64_t)aEntityCount * iterations, add);
+		Report("RemoveComponent<Velocity>", aEntityCount, (uint64_t)aEntityCount * iterations, remove);
+	}
+
+	void BenchmarkForEach(uint32_t aEntityCount)
+	{
+		constexpr uint32_t iterations = 10;
+
+		Wire::Registry registry;
+		std::vector<Wire::EntityId> entities(aEntityCount);
+		registry.CreateEntities(aEntityCount, entities);
+		registry.AddComponents<BenchPosition>(entities, BenchPosition{ 0.f, 0.f, 0.f });
+		registry.AddComponents<BenchVelocity>(entities, BenchVelocity{ 1.f, 2.f, 3.f });
+		registry.AddComponents<BenchMass>(entities, BenchMass{ 2.f });
+
+		const double one = MeasureMilliseconds(iterations, [&]()
+			{
+				registry.ForEach<BenchPosition>([](Wire::EntityId, BenchPosition& position) { position.x += 0.016f; });
+			});
+
+		const double two = MeasureMilliseconds(iterations, [&]()
+			{
+				registry.ForEach<BenchPosition, const BenchVelocity>([](Wire::EntityId, BenchPosition& position, const BenchVelocity& velocity)
+					{
+						position.x += velocity.x * 0.016f;
+					});
+			});
+
+		const double three = MeasureMilliseconds(iterations, [&]()
+			{
+				registry.ForEach<BenchPosition, const BenchVelocity, const BenchMass>([](Wire::EntityId, BenchPosition& position, const BenchVelocity& velocity, const BenchMass& mass)
+					{
+						position.x += velocity.x / mass.mass * 0.016f;
+					});
+			});
+
+		Report("ForEach<Position>", aEntityCount, aEntityCount, one);
+		Report("ForEach<Position, Velocity>", aEntityCount, aEntityCount, two);
+		Report("ForEach<Position, Velocity, Mass>", aEntityCount, aEntityCount, three);
+	}
+
+	void BenchmarkComponentView(uint32_t aEntityCount)
+	{
+		constexpr uint32_t iterations = 10;
+
+		Wire::Registry registry;
+		std::vector<Wire::EntityId> entities(aEntityCount);
+		registry.CreateEntities(aEntityCount, entities);
+		registry.AddComponents<BenchPosition>(entities, BenchPosition{ 0.f, 0.f, 0.f });
+
+		float sum = 0.f;
+		const double view = MeasureMilliseconds(iterations, [&]()
+			{
+				for (const Wire::EntityId entity : registry.GetComponentView<BenchPosition>())
+				{
+					sum += registry.GetComponent<BenchPosition>(entity).x;
+				}
+			});
+
+		Report("GetComponentView + GetComponent", aEntityCount, aEntityCount, view);
+
+		// Keeps the loop from being optimized away
+		if (sum != 0.f)
+		{
+			printf("%f\n", sum);
+		}
+	}
+
+	void BenchmarkSerializer(uint32_t aEntityCount)
+	{
+		constexpr uint32_t iterations = 5;
+		const std::filesystem::path path = std::filesystem::temp_directory_path() / "WireBenchmark.wreg";
+
+		Wire::Registry registry;
+		std::vector<Wire::EntityId> entities(aEntityCount);
+		registry.CreateEntities(aEntityCount, entities);
+		registry.AddComponents<BenchPosition>(entities, BenchPosition{ 0.f, 0.f, 0.f });
+		registry.AddComponents<BenchVelocity>(entities, BenchVelocity{ 1.f, 2.f, 3.f });
+
+		const double save = MeasureMilliseconds(iterations, [&]() { Wire::Serializer::SerializeRegistry(registry, path); });
+		const double load = MeasureMilliseconds(iterations, [&]()
+			{
+				Wire::Registry loaded;
+				Wire::Serializer::DeserializeRegistry(path, loaded);
+			});
+
+		Report("SerializeRegistry (2 components)", aEntityCount, aEntityCount, save);
+		Report("DeserializeRegistry (2 components)", aEntityCount, aEntityCount, load);
+
+		std::filesystem::remove(path);
+	}
+
+	void BenchmarkParallelForEach(uint32_t aEntityCount)
+	{
+		Wire::Registry registry;
+		for (uint32_t i = 0; i < aEntityCount; i++)
+		{
+			const Wire::EntityId entity = registry.CreateEntity();
+			registry.AddComponent<BenchPosition>(entity, 0.f, 0.f, 0.f);
+			registry.AddComponent<BenchVelocity>(entity, 1.f, (float)i, 0.5f);
+		}
+
+		// Enough work per entity to be compute bound rather than purely memory bound
+		auto update = [](Wire::EntityId, BenchPosition& position, BenchVelocity& velocity)
+		{
+			for (uint32_t i = 0; i < 8; i++)
+			{
+				position.x += std::sin(velocity.x) * 0.016f;
+				position.y += std::cos(velocity.y) * 0.016f;
+				position.z += std::sqrt(velocity.z + position.x * position.x) * 0.016f;
+			}
+		};
+
+		const double singleThreaded = MeasureMilliseconds(10, [&]() { registry.ForEach<BenchPosition, BenchVelocity>(update); });
+		printf("ForEach<Position, Velocity> %u entities: %.3f ms\n", aEntityCount, singleThreaded);
+
+		const uint32_t maxThreads = std::max(std::thread::hardware_concurrency(), 1u);
+		for (uint32_t threadCount = 1; threadCount <= maxThreads; threadCount = (threadCount == maxThreads) ? maxThreads + 1 : std::min(threadCount * 2, maxThreads))
+		{
+			Wire::JobSystem jobSystem(threadCount);
+			const double time = MeasureMilliseconds(10, [&]() { registry.ParallelForEach<BenchPosition, BenchVelocity>(update, jobSystem); });
+
+			printf("ParallelForEach<Position, Velocity> %u entities, %2u threads: %.3f ms (%.2fx)\n", aEntityCount, threadCount, time, singleThreaded / time);
+		}
+	}
+
+	void BenchmarkOwningGroup(uint32_t aEntityCount)
+	{
+		Wire::Registry registry;
+		for (uint32_t i = 0; i < aEntityCount; i++)
+		{
+			const Wire::EntityId entity = registry.CreateEntity();
+			registry.AddComponent<BenchPosition>(entity, 0.f, 0.f, 0.f);
+
+			// Only some entities match, in an order unrelated to the position pool
+			if (i % 3 != 0)
+			{
+				registry.AddComponent<BenchVelocity>(entity, 1.f, (float)i, 0.5f);
+			}
+		}
+
+		for (uint32_t i = 0; i < aEntityCount; i += 2)
+		{
+			registry.RemoveComponent<BenchPosition>(registry.GetAllEntities()[i]);
+			registry.AddComponent<BenchPosition>(registry.GetAllEntities()[i], 0.f, 0.f, 0.f);
+		}
+
+		auto update = [](Wire::EntityId, BenchPosition& position, const BenchVelocity& velocity)
+		{
+			position.x += velocity.x * 0.016f;
+			position.y += velocity.y * 0.016f;
+			position.z += velocity.z * 0.016f;
+		};
+
+		const double view = MeasureMilliseconds(20, [&]() { registry.ForEach<BenchPosition, const BenchVelocity>(update); });
+
+		registry.CreateGroup<BenchPosition, BenchVelocity>();
+		const double group = MeasureMilliseconds(20, [&]() { registry.ForEach<BenchPosition, const BenchVelocity>(update); });
+
+		printf("ForEach<Position, Velocity> %u entities, view: %.3f ms, owning group: %.3f ms (%.2fx)\n", aEntityCount, view, group, view / group);
+	}
+
+	void BenchmarkQuery(uint32_t aEntityCount)
+	{
+		Wire::Registry registry;
+		std::vector<Wire::EntityId> entities(aEntityCount);
+		registry.CreateEntities(aEntityCount, entities);
+		registry.AddComponents<BenchPosition>(entities, BenchPosition{ 0.f, 0.f, 0.f });
+
+		// Half of the entities move and a fifth have mass, a tenth have both
+		for (uint32_t i = 0; i < aEntityCount; i++)
+		{
+			if (i % 2 == 0)
+			{
+				registry.AddComponent<BenchVelocity>(entities[i], 1.f, 2.f, 3.f);
+			}
+
+			if (i % 5 == 0)
+			{
+				registry.AddComponent<BenchMass>(entities[i], 2.f);
+			}
+		}
+
+		auto update = [](Wire::EntityId, BenchPosition& position, const BenchVelocity& velocity, const BenchMass& mass)
+		{
+			position.x += velocity.x / mass.mass * 0.016f;
+		};
+
+		const double view = MeasureMilliseconds(20, [&]() { registry.ForEach<BenchPosition, const BenchVelocity, const BenchMass>(update); });
+
+		const Wire::Query<BenchPosition, const BenchVelocity, const BenchMass> query = registry.GetQuery<BenchPosition, const BenchVelocity, const BenchMass>();
+		const double cached = MeasureMilliseconds(20, [&]() { query.ForEach(update); });
+
+		printf("ForEach<Position, Velocity, Mass> %u entities, view: %.3f ms, cached query: %.3f ms (%.2fx)\n", aEntityCount, view, cached, view / cached);
+	}
+
+	void BenchmarkColumnLayout(uint32_t aEntityCount)
+	{
+		Wire::Registry registry;
+		std::vector<Wire::EntityId> entities(aEntityCount);
+		registry.CreateEntities(aEntityCount, entities);
+
+		BenchParticle particle{};
+		particle.lifetime = 2.f;
+		registry.AddComponents<BenchParticle>(entities, particle);
+
+		// Ages every particle, touching one float out of a 56 byte component
+		float delta = 0.016f;
+		const double rows = MeasureMilliseconds(50, [&]()
+		{
+			registry.ForEach<BenchParticle>([delta](Wire::EntityId, BenchParticle& particle) { particle.age += delta; });
+		});
+
+		registry.EnableColumnLayout<BenchParticle>();
+		Wire::ComponentColumn<float> ages = registry.GetColumn<float>(BenchParticle::comp_guid, "Age");
+
+		const double columns = MeasureMilliseconds(50, [&]()
+		{
+			ages.ForEachChunk([delta](std::span<float> chunk)
+			{
+				for (float& age : chunk)
+				{
+					age += delta;
+				}
+			});
+		});
+
+		printf("Update one property %u entities, rows: %.3f ms, columns: %.3f ms (%.2fx)\n", aEntityCount, rows, columns, rows / columns);
+	}
+
+	void BenchmarkPropertyAccess(uint32_t aEntityCount)
+	{
+		Wire::Registry registry;
+		std::vector<Wire::EntityId> entities(aEntityCount);
+		registry.CreateEntities(aEntityCount, entities);
+		registry.AddComponents<BenchParticle>(entities, BenchParticle{});
+
+		// What a generic editor or script binding did before, a copy of the whole component each way
+		const double copies = MeasureMilliseconds(10, [&]()
+		{
+			for (const Wire::EntityId entity : entities)
+			{
+				std::vector<uint8_t> data = registry.GetPools().at(BenchParticle::comp_guid).GetComponentData(entity);
+				reinterpret_cast<BenchParticle*>(data.data())->age += 0.016f;
+				registry.SetComponentData(data, BenchParticle::comp_guid, entity);
+			}
+		});
+
+		const Wire::Registry::Property age = registry.FindProperty(BenchParticle::comp_guid, Wire::ComponentRegistry::HashPropertyName("Age"));
+		const double properties = MeasureMilliseconds(10, [&]()
+		{
+			for (const Wire::EntityId entity : entities)
+			{
+				registry.SetProperty<float>(entity, age, registry.GetProperty<float>(entity, age) + 0.016f);
+			}
+		});
+
+		printf("Reflective property update %u entities, component copies: %.3f ms, GetProperty/SetProperty: %.3f ms (%.2fx)\n", aEntityCount, copies, properties, copies / properties);
+	}
+
+	void BenchmarkBulkCreation(uint32_t aEntityCount)
+	{
+		std::vector<Wire::EntityId> entities(aEntityCount);
+
+		const double perEntityCreate = MeasureMilliseconds(10, [&]()
+			{
+				Wire::Registry registry;
+				for (uint32_t i = 0; i < aEntityCount; i++)
+				{
+					const Wire::EntityId entity = registry.CreateEntity();
+					registry.AddComponent<BenchPosition>(entity, 0.f, 0.f, 0.f);
+					registry.AddComponent<BenchVelocity>(entity, 1.f, 0.f, 0.f);
+				}
+			});
+
+		const double bulkCreate = MeasureMilliseconds(10, [&]()
+			{
+				Wire::Registry registry;
+				registry.CreateEntities(aEntityCount, entities);
+				registry.AddComponents<BenchPosition>(entities, BenchPosition{ 0.f, 0.f, 0.f });
+				registry.AddComponents<BenchVelocity>(entities, BenchVelocity{ 1.f, 0.f, 0.f });
+			});
+
+		printf("Create %u entities with 2 components, per entity: %.3f ms, bulk: %.3f ms (%.2fx)\n", aEntityCount, perEntityCreate, bulkCreate, perEntityCreate / bulkCreate);
+
+		// Only the removal is timed, the registry is rebuilt outside the measurement
+		double perEntityRemove = 0.0;
+		double bulkRemove = 0.0;
+
+		for (uint32_t iteration = 0; iteration < 10; iteration++)
+		{
+			Wire::Registry registry;
+			registry.CreateEntities(aEntityCount, entities);
+			registry.AddComponents<BenchPosition>(entities, BenchPosition{ 0.f, 0.f, 0.f });
+			registry.AddComponents<BenchVelocity>(entities, BenchVelocity{ 1.f, 0.f, 0.f });
+
+			Wire::Registry bulkRegistry = registry;
+
+			perEntityRemove += MeasureMilliseconds(1, [&]()
+				{
+					for (const Wire::EntityId entity : entities)
+					{
+						registry.RemoveEntity(entity);
+					}
+				});
+
+			bulkRemove += MeasureMilliseconds(1, [&]() { bulkRegistry.RemoveEntities(entities); });
+		}
+
+		printf("Remove %u entities with 2 components, per entity: %.3f ms, bulk: %.3f ms (%.2fx)\n", aEntityCount, perEntityRemove / 10, bulkRemove / 10, perEntityRemove / bulkRemove);
+	}
+
+	void BenchmarkArena(uint32_t aEntityCount)
+	{
+		constexpr uint32_t iterations = 5;
+		std::vector<Wire::EntityId> entities(aEntityCount);
+
+		// Builds a world with some churn, then times its teardown separately
+		auto buildAndDestroy = [&](std::pmr::memory_resource* aResource, double& outBuild, double& outDestroy)
+		{
+			std::optional<Wire::Registry> registry;
+			outBuild += MeasureMilliseconds(1, [&]()
+				{
+					registry.emplace(aResource);
+					registry->CreateEntities(aEntityCount, entities);
+					registry->AddComponents<BenchPosition>(entities, BenchPosition{ 0.f, 0.f, 0.f });
+
+					for (uint32_t i = 0; i < aEntityCount; i += 2)
+					{
+						registry->AddComponent<BenchVelocity>(entities[i], 1.f, 0.f, 0.f);
+					}
+
+					for (uint32_t i = 1; i < aEntityCount; i += 64)
+					{
+						registry->AddChild(entities[0], entities[i]);
+					}
+
+					for (uint32_t i = 0; i < aEntityCount; i += 4)
+					{
+						registry->RemoveComponent<BenchVelocity>(entities[i]);
+					}
+				});
+
+			outDestroy += MeasureMilliseconds(1, [&]() { registry.reset(); });
+		};
+
+		double heapBuild = 0.0;
+		double heapDestroy = 0.0;
+		double arenaBuild = 0.0;
+		double arenaDestroy = 0.0;
+
+		// Every world reuses the blocks the arena kept from the previous one
+		Wire::Arena arena;
+		for (uint32_t iteration = 0; iteration < iterations; iteration++)
+		{
+			buildAndDestroy(std::pmr::get_default_resource(), heapBuild, heapDestroy);
+
+			buildAndDestroy(&arena, arenaBuild, arenaDestroy);
+			arenaDestroy += MeasureMilliseconds(1, [&]() { arena.Reset(); });
+		}
+
+		printf("Build world %u entities, heap: %.3f ms, arena: %.3f ms (%.2fx)\n", aEntityCount, heapBuild / iterations, arenaBuild / iterations, heapBuild / arenaBuild);
+		printf("Destroy world %u entities, heap: %.3f ms, arena: %.3f ms (%.2fx)\n", aEntityCount, heapDestroy / iterations, arenaDestroy / iterations, heapDestroy / arenaDestroy);
+	}
+
+	void BenchmarkClone(uint32_t aEntityCount)
+	{
+		constexpr uint32_t iterations = 20;
+		std::vector<Wire::EntityId> entities(aEntityCount);
+
+		Wire::Registry registry;
+		registry.CreateEntities(aEntityCount, entities);
+		registry.AddComponents<BenchPosition>(entities, BenchPosition{ 0.f, 0.f, 0.f });
+
+		for (uint32_t i = 1; i < aEntityCount; i += 64)
+		{
+			registry.AddChild(entities[0], entities[i]);
+		}
+
+		const double clone = MeasureMilliseconds(iterations, [&]() { Wire::Registry copy = registry.Clone(); });
+
+		// The first write to a clone copies the pages it touches and the entity list
+		const double cloneAndCreate = MeasureMilliseconds(iterations, [&]()
+			{
+				Wire::Registry copy = registry.Clone();
+				copy.CreateEntity();
+			});
+
+		const double copy = MeasureMilliseconds(iterations, [&]() { Wire::Registry copy = registry; });
+
+		printf("Clone %u entities: %.3f ms, clone and create: %.3f ms, full copy: %.3f ms\n", aEntityCount, clone, cloneAndCreate, copy);
+	}
+
+	void BenchmarkDelta(uint32_t aEntityCount)
+	{
+		constexpr uint32_t iterations = 10;
+		std::vector<Wire::EntityId> entities(aEntityCount);
+
+		Wire::Registry registry;
+		registry.CreateEntities(aEntityCount, entities);
+		registry.AddComponents<BenchPosition>(entities, BenchPosition{ 0.f, 0.f, 0.f });
+
+		// A few changes spread over the world, each one copies a page
+		const Wire::Snapshot previous(registry);
+		for (uint32_t i = 0; i < 10; i++)
+		{
+			registry.GetComponent<BenchPosition>(entities[i * (aEntityCount / 10)]).x = 1.f;
+		}
+
+		const Wire::Snapshot current(registry);
+
+		size_t deltaSize = 0;
+		const double time = MeasureMilliseconds(iterations, [&]() { deltaSize = Wire::DeltaSerializer::CreateDelta(previous, current).size(); });
+
+		printf("CreateDelta %u entities, 10 changed: %.3f ms, %zu bytes\n", aEntityCount, time, deltaSize);
+	}
+
+	void BenchmarkSceneFolderLoad(uint32_t aEntityCount)
+	{
+		const std::filesystem::path sceneFolder = std::filesystem::temp_directory_path() / "WireBenchmarkScene";
+		std::filesystem::remove_all(sceneFolder);
+
+		{
+			Wire::Registry registry;
+			for (uint32_t i = 0; i < aEntityCount; i++)
+			{
+				const Wire::EntityId entity = registry.CreateEntity();
+				registry.AddComponent<BenchPosition>(entity, (float)i, 0.f, 0.f);
+				registry.AddComponent<BenchVelocity>(entity, 1.f, 0.f, 0.f);
+
+				Wire::Serializer::SerializeEntityToFile(entity, registry, sceneFolder);
+			}
+		}
+
+		const double sequential = MeasureMilliseconds(1, [&]()
+			{
+				Wire::Registry registry;
+				for (const auto& entry : std::filesystem::directory_iterator(sceneFolder))
+				{
+					Wire::Serializer::DeserializeEntityToRegistry(entry.path(), registry);
+				}
+			});
+
+		printf("DeserializeEntityToRegistry %u entity files: %.3f ms\n", aEntityCount, sequential);
+
+		const uint32_t maxThreads = std::max(std::thread::hardware_concurrency(), 1u);
+		for (uint32_t threadCount = 1; threadCount <= maxThreads; threadCount = (threadCount == maxThreads) ? maxThreads + 1 : std::min(threadCount * 2, maxThreads))
+		{
+			Wire::JobSystem jobSystem(threadCount);
+			const double time = MeasureMilliseconds(1, [&]()
+				{
+					Wire::Registry registry;
+					Wire::Serializer::DeserializeSceneFolder(sceneFolder, registry, jobSystem);
+				});
+
+			printf("DeserializeSceneFolder %u entity files, %2u threads: %.3f ms (%.2fx)\n", aEntityCount, threadCount, time, sequential / time);
+		}
+
+		std::filesystem::remove_all(sceneFolder);
+	}
+}
+
+int main(int argc, char** argv)
+{
+	// Core operations at the same sizes on every platform, so runs can be compared for regressions
+	for (const uint32_t entityCount : { 10000u, 100000u, 1000000u })
+	{
+		BenchmarkEntityLifetime(entityCount);
+		BenchmarkComponentChurn(entityCount);
+		BenchmarkForEach(entityCount);
+		BenchmarkComponentView(entityCount);
+		BenchmarkSerializer(entityCount);
+	}
+
+	// Passing --core skips the feature comparisons below
+	if (argc > 1 && std::string_view(argv[1]) == "--core")
+	{
+		return 0;
+	}
+
+	BenchmarkParallelForEach(100000);
+	BenchmarkParallelForEach(1000000);
+
+	BenchmarkOwningGroup(100000);
+	BenchmarkOwningGroup(1000000);
+
+	BenchmarkQuery(100000);
+	BenchmarkQuery(1000000);
+
+	BenchmarkColumnLayout(100000);
+	BenchmarkColumnLayout(1000000);
+
+	BenchmarkPropertyAccess(100000);
+
+	BenchmarkBulkCreation(50000);
+	BenchmarkBulkCreation(500000);
+
+	BenchmarkArena(100000);
+	BenchmarkArena(1000000);
+
+	BenchmarkClone(100000);
+	BenchmarkClone(1000000);
+
+	BenchmarkDelta(100000);
+	BenchmarkDelta(1000000);
+
+	BenchmarkSceneFolderLoad(10000);
+	BenchmarkSceneFolderLoad(100000);
+
+	return 0;
+}
\ No newline at end of file
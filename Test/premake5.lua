@@ -1,6 +1,6 @@
 project "Test"
 	location "."
-	kind "SharedLib"
+	kind "ConsoleApp"
 	language "C++"
 	cppdialect "C++20"
 
@@ -17,17 +17,23 @@ project "Test"
 	includedirs
 	{
 		"src",
-		"../Wire/src/",
-		"$(VCInstallDir)UnitTest/include"
+		"../Wire/src/"
 	}
-	
-	libdirs
+
+	links
 	{
-		"$(VCInstallDir)UnitTest/lib"
+		"Wire"
 	}
 
+	-- The MSVC unit test framework loads the tests as a library, elsewhere TestMain.cpp runs them
 	filter "system:windows"
+		kind "SharedLib"
 		systemversion "latest"
+		includedirs { "$(VCInstallDir)UnitTest/include" }
+		libdirs { "$(VCInstallDir)UnitTest/lib" }
+
+	filter "system:linux"
+		links { "pthread" }
 
 		filter "configurations:Debug"
 			defines { "LP_DEBUG", "LP_ENABLE_ASSERTS" }
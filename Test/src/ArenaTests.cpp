@@ -0,0 +1,171 @@
+#include "TestFramework.h"
+#include "TestComponents.h"
+
+#include <Wire/Wire.h>
+
+#include <memory_resource>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace WireTests
+{
+	// Counts what is allocated through it and forwards to new and delete
+	class CountingResource : public std::pmr::memory_resource
+	{
+	public:
+		size_t allocations = 0;
+		size_t bytesInUse = 0;
+
+	private:
+		void* do_allocate(size_t aBytes, size_t aAlignment) override
+		{
+			allocations++;
+			bytesInUse += aBytes;
+			return std::pmr::new_delete_resource()->allocate(aBytes, aAlignment);
+		}
+
+		void do_deallocate(void* aPointer, size_t aBytes, size_t aAlignment) override
+		{
+			bytesInUse -= aBytes;
+			std::pmr::new_delete_resource()->deallocate(aPointer, aBytes, aAlignment);
+		}
+
+		bool do_is_equal(const std::pmr::memory_resource& aOther) const noexcept override
+		{
+			return this == &aOther;
+		}
+	};
+
+	// Replaces the default resource for the lifetime of the scope
+	struct DefaultResourceScope
+	{
+		DefaultResourceScope(std::pmr::memory_resource* aResource) : previous(std::pmr::set_default_resource(aResource)) {}
+		~DefaultResourceScope() { std::pmr::set_default_resource(previous); }
+
+		std::pmr::memory_resource* previous;
+	};
+
+	static std::vector<Wire::EntityId> BuildWorld(Wire::Registry& aRegistry, size_t aCount)
+	{
+		std::vector<Wire::EntityId> entities(aCount);
+		aRegistry.CreateEntities(entities.size(), entities);
+		aRegistry.AddComponents<Position>(entities, Position{ 1.f, 2.f });
+
+		for (size_t i = 0; i < entities.size(); i += 2)
+		{
+			aRegistry.AddComponent<Velocity>(entities[i], (float)i);
+		}
+
+		return entities;
+	}
+
+	static size_t CountMoving(Wire::Registry& aRegistry)
+	{
+		size_t count = 0;
+		aRegistry.ForEach<Position, Velocity>([&](Wire::EntityId, Position&, Velocity&) { count++; });
+		return count;
+	}
+
+	TEST_CLASS(ArenaTests)
+	{
+	public:
+
+		TEST_METHOD(EverythingComesFromTheResource)
+		{
+			CountingResource upstream;
+			CountingResource fallback;
+			DefaultResourceScope scope(&fallback);
+
+			Wire::Arena arena(4096, &upstream);
+			{
+				Wire::Registry registry(&arena);
+				const std::vector<Wire::EntityId> entities = BuildWorld(registry, 3000);
+
+				registry.CreateGroup<Position, Velocity>();
+				registry.GetQuery<Velocity, Position>();
+				registry.EnableColumnLayout<Body>();
+				registry.AddComponents<Body>(entities, Body{});
+
+				for (size_t i = 1; i < 100; i++)
+				{
+					registry.AddChild(entities[0], entities[i]);
+				}
+
+				for (size_t i = 200; i < entities.size(); i += 7)
+				{
+					registry.RemoveEntity(entities[i]);
+				}
+
+				Wire::Registry clone = registry.Clone();
+				clone.GetComponent<Position>(entities[1]).x = 9.f;
+				Wire::Registry copy = clone;
+
+				Assert::IsTrue(copy.GetMemoryResource() == &arena);
+				Assert::AreEqual(9.f, copy.GetComponent<Position>(entities[1]).x);
+				Assert::AreEqual(1.f, registry.GetComponent<Position>(entities[1]).x);
+				Assert::AreEqual(CountMoving(registry), CountMoving(copy));
+				Assert::AreEqual((size_t)0, fallback.allocations);
+			}
+
+			Assert::AreEqual((size_t)0, arena.GetBytesInUse());
+
+			// A second world reuses the blocks of the first
+			const size_t upstreamAllocations = upstream.allocations;
+			arena.Reset();
+			{
+				Wire::Registry registry(&arena);
+				BuildWorld(registry, 3000);
+			}
+
+			Assert::AreEqual(upstreamAllocations, upstream.allocations);
+
+			arena.Release();
+			Assert::AreEqual((size_t)0, upstream.bytesInUse);
+		}
+
+		TEST_METHOD(MoveAssignAcrossResources)
+		{
+			Wire::Arena arena;
+			Wire::Registry source(&arena);
+			const std::vector<Wire::EntityId> entities = BuildWorld(source, 3000);
+			source.CreateGroup<Position, Velocity>();
+			const size_t queried = source.GetQuery<Position, Velocity>().GetSize();
+
+			Wire::Registry target;
+			target = std::move(source);
+
+			Assert::IsTrue(target.GetMemoryResource() == std::pmr::get_default_resource());
+			Assert::AreEqual((size_t)1500, CountMoving(target));
+			Assert::AreEqual(queried, target.GetQuery<Position, Velocity>().GetSize());
+
+			// The group and the query follow changes to the moved registry
+			target.RemoveComponent<Velocity>(entities[0]);
+			target.AddComponent<Velocity>(entities[1], 1.f);
+			Assert::AreEqual((size_t)1500, CountMoving(target));
+			Assert::AreEqual((size_t)1500, target.GetQuery<Position, Velocity>().GetSize());
+
+			// The moved from registry is empty and usable
+			Assert::AreEqual((size_t)0, source.GetAllEntities().size());
+			BuildWorld(source, 10);
+			Assert::AreEqual((size_t)5, CountMoving(source));
+		}
+
+		TEST_METHOD(MoveAssignSameResource)
+		{
+			Wire::Arena arena;
+			Wire::Registry source(&arena);
+			BuildWorld(source, 100);
+			source.CreateGroup<Position, Velocity>();
+			const Wire::ComponentPool* pool = &source.GetPools().at(Position::comp_guid);
+
+			Wire::Registry target(&arena);
+			BuildWorld(target, 10);
+			target = std::move(source);
+
+			// The pools are taken over, not copied
+			Assert::IsTrue(pool == &target.GetPools().at(Position::comp_guid));
+			Assert::AreEqual((size_t)50, CountMoving(target));
+		}
+	};
+}
\ No newline at end of file
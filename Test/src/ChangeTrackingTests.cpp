@@ -0,0 +1,69 @@
+#include "TestFramework.h"
+#include "TestComponents.h"
+
+#include <Wire/Wire.h>
+
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace WireTests
+{
+	TEST_CLASS(ChangeTrackingTests)
+	{
+	public:
+		TEST_METHOD(VisitsComponentsChangedSinceATick)
+		{
+			Wire::Registry registry;
+			registry.EnableChangeTracking<Position>();
+
+			std::vector<Wire::EntityId> entities(10);
+			registry.CreateEntities(entities.size(), entities);
+			for (const Wire::EntityId entity : entities)
+			{
+				registry.AddComponent<Position>(entity, 0.f, 0.f);
+			}
+
+			const uint64_t since = registry.AdvanceTick();
+
+			// Mutable access marks, const access does not
+			registry.GetComponent<Position>(entities[2]).x = 1.f;
+			registry.GetComponent<const Position>(entities[3]);
+			registry.MarkChanged<Position>(entities[7]);
+			registry.ForEach<const Position>([](Wire::EntityId, const Position&) {});
+
+			const Wire::EntityId added = registry.CreateEntity();
+			registry.AddComponent<Position>(added, 0.f, 0.f);
+
+			std::vector<Wire::EntityId> changed;
+			registry.ForEachChanged<Position>(since, [&](Wire::EntityId id, Position&) { changed.emplace_back(id); });
+
+			Assert::IsTrue(changed == std::vector<Wire::EntityId>{ entities[2], entities[7], added });
+		}
+
+		TEST_METHOD(VersionsFollowMovedComponents)
+		{
+			Wire::Registry registry;
+			registry.EnableChangeTracking<Position>();
+
+			const Wire::EntityId removed = registry.CreateEntity();
+			const Wire::EntityId last = registry.CreateEntity();
+			registry.AddComponent<Position>(removed, 0.f, 0.f);
+			registry.AddComponent<Position>(last, 0.f, 0.f);
+
+			const uint64_t since = registry.AdvanceTick();
+			registry.GetComponent<Position>(last).y = 1.f;
+
+			// The last component moves into the freed slot and keeps its version
+			registry.RemoveComponent<Position>(removed);
+
+			std::vector<Wire::EntityId> changed;
+			registry.ForEachChanged<Position>(since, [&](Wire::EntityId id, Position&) { changed.emplace_back(id); });
+			Assert::IsTrue(changed == std::vector<Wire::EntityId>{ last });
+
+			changed.clear();
+			registry.ForEachChanged<Position>(registry.AdvanceTick(), [&](Wire::EntityId id, Position&) { changed.emplace_back(id); });
+			Assert::IsTrue(changed.empty());
+		}
+	};
+}
\ No newline at end of file
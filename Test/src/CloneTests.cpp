@@ -0,0 +1,62 @@
+#include "TestFramework.h"
+#include "TestComponents.h"
+
+#include <Wire/Wire.h>
+
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace WireTests
+{
+	TEST_CLASS(CloneTests)
+	{
+	public:
+		TEST_METHOD(ClonesAreIndependent)
+		{
+			// Enough entities to span several slot pages
+			Wire::Registry registry;
+			std::vector<Wire::EntityId> entities(10000);
+			registry.CreateEntities(entities.size(), entities);
+			registry.AddChild(entities[0], entities[9000]);
+
+			Wire::Registry clone = registry.Clone();
+
+			registry.RemoveEntity(entities[5000]);
+			registry.RemoveEntity(entities[9000]);
+			const Wire::EntityId created = registry.CreateEntity();
+
+			Assert::IsTrue(clone.IsValid(entities[5000]));
+			Assert::IsTrue(clone.IsValid(entities[9000]));
+			Assert::IsFalse(clone.IsValid(created));
+			Assert::AreEqual(entities.size(), clone.GetAllEntities().size());
+			Assert::IsTrue(clone.GetParent(entities[9000]) == entities[0]);
+
+			Assert::IsFalse(registry.IsValid(entities[5000]));
+			Assert::IsTrue(registry.IsValid(created));
+			Assert::IsTrue(registry.GetChildren(entities[0]).empty());
+			Assert::AreEqual((size_t)1, clone.GetChildren(entities[0]).size());
+			Assert::AreEqual(entities.size() - 1, registry.GetAllEntities().size());
+
+			// The clone reuses its own free list, not the original's
+			const Wire::EntityId cloneCreated = clone.CreateEntity();
+			Assert::IsTrue(clone.IsValid(cloneCreated));
+			Assert::AreEqual((uint32_t)entities.size() + 1, Wire::Entity::GetIndex(cloneCreated));
+		}
+
+		TEST_METHOD(StaleHandlesStayInvalidInClones)
+		{
+			Wire::Registry registry;
+			const Wire::EntityId removed = registry.CreateEntity();
+			registry.RemoveEntity(removed);
+
+			Wire::Registry clone = registry.Clone();
+			const Wire::EntityId reused = clone.CreateEntity();
+
+			Assert::AreEqual(Wire::Entity::GetIndex(removed), Wire::Entity::GetIndex(reused));
+			Assert::IsFalse(clone.IsValid(removed));
+			Assert::IsTrue(clone.IsValid(reused));
+			Assert::IsFalse(registry.IsValid(reused));
+		}
+	};
+}
\ No newline at end of file
@@ -0,0 +1,86 @@
+#include "TestFramework.h"
+#include "TestComponents.h"
+
+#include <Wire/Wire.h>
+
+#include <stdexcept>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace WireTests
+{
+	TEST_CLASS(ColumnTests)
+	{
+	public:
+
+		TEST_METHOD(ColumnsKeepValuesAcrossRemoval)
+		{
+			Wire::Registry registry;
+			std::vector<Wire::EntityId> entities;
+			std::vector<Position> positions;
+
+			for (int i = 0; i < 3000; i++)
+			{
+				entities.push_back(registry.CreateEntity());
+				positions.push_back({ (float)i, (float)-i });
+			}
+
+			registry.EnableColumnLayout<Position>();
+			registry.AddComponents<Position>(entities, std::span<const Position>(positions));
+
+			for (int i = 0; i < 3000; i += 3)
+			{
+				registry.RemoveComponent<Position>(entities[i]);
+			}
+
+			const std::vector<Position> remaining = registry.GetAllComponents<Position>();
+			const std::span<const Wire::EntityId> owners = registry.GetComponentView<Position>();
+			Assert::AreEqual((size_t)2000, remaining.size());
+
+			for (size_t i = 0; i < remaining.size(); i++)
+			{
+				Assert::AreEqual(remaining[i].x, -remaining[i].y);
+				Assert::AreEqual(entities[(size_t)remaining[i].x], owners[i]);
+			}
+
+			float sum = 0.f;
+			Wire::ComponentColumn<float> column = registry.GetColumn<float>(Position::comp_guid, "Y");
+			column.ForEachChunk([&](std::span<float> values)
+			{
+				for (const float value : values)
+				{
+					sum += value;
+				}
+			});
+
+			float expected = 0.f;
+			for (const Position& position : remaining)
+			{
+				expected += position.y;
+			}
+
+			Assert::AreEqual(expected, sum);
+		}
+
+		TEST_METHOD(TypedAccessThrows)
+		{
+			Wire::Registry registry;
+			const Wire::EntityId entity = registry.CreateEntity();
+			const Wire::EntityId other = registry.CreateEntity();
+
+			registry.EnableColumnLayout<Position>();
+			registry.AddComponents<Position>(std::span<const Wire::EntityId>(&entity, 1), Position{ 1.f, 2.f });
+
+			Assert::ExpectException<std::logic_error>([&]() { registry.AddComponent<Position>(other, 3.f, 4.f); });
+			Assert::ExpectException<std::logic_error>([&]() { registry.GetComponent<Position>(entity); });
+			Assert::ExpectException<std::logic_error>([&]() { registry.ForEach<Position>([](Wire::EntityId, Position&) {}); });
+			Assert::ExpectException<std::logic_error>([&]() { registry.GetQuery<Position>(); });
+
+			// The failed add leaves the pool untouched
+			Assert::IsFalse(registry.HasComponent<Position>(other));
+			Assert::AreEqual((size_t)1, registry.GetComponentView<Position>().size());
+			Assert::AreEqual(2.f, registry.GetAllComponents<Position>().front().y);
+		}
+	};
+}
\ No newline at end of file
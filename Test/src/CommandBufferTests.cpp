@@ -0,0 +1,109 @@
+#include "TestFramework.h"
+#include "TestComponents.h"
+
+#include <Wire/Wire.h>
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace WireTests
+{
+	// Not registered, so CommandBuffer can not tell that its pool has ComponentOps
+	struct UnregisteredTagged
+	{
+		CREATE_COMPONENT_GUID("{1D4B7A60-2C4E-4F0B-9F3A-6E2D1C0B5A06}"_guid);
+		std::string label;
+	};
+
+	TEST_CLASS(CommandBufferTests)
+	{
+	public:
+		TEST_METHOD(PlaysBackPendingEntities)
+		{
+			Wire::Registry registry;
+			Wire::CommandBuffer buffer;
+
+			const Wire::CommandBuffer::PendingEntity pending = buffer.CreateEntity();
+			buffer.AddComponent<Position>(pending, 1.f, 2.f);
+			buffer.AddComponent<Velocity>(pending, 3.f);
+
+			registry.Playback(buffer);
+
+			const Wire::EntityId created = buffer.GetCreatedEntity(pending);
+			Assert::IsTrue(registry.IsValid(created));
+			Assert::AreEqual(2.f, registry.GetComponent<Position>(created).y);
+			Assert::AreEqual(3.f, registry.GetComponent<Velocity>(created).dx);
+			Assert::IsTrue(buffer.IsEmpty());
+		}
+
+		TEST_METHOD(DestroysRunLast)
+		{
+			Wire::Registry registry;
+			const Wire::EntityId destroyed = registry.CreateEntity();
+			const Wire::EntityId kept = registry.CreateEntity();
+			registry.AddComponent<Position>(kept, 0.f, 0.f);
+
+			// Recorded while iterating, the destroy is recorded before the other commands on the same entity
+			Wire::CommandBuffer buffer;
+			buffer.DestroyEntity(destroyed);
+			buffer.AddComponent<Position>(destroyed, 1.f, 1.f);
+			buffer.SetComponent<Position>(kept, Position{ 4.f, 5.f });
+			buffer.RemoveComponent<Velocity>(kept);
+
+			registry.Playback(buffer);
+
+			Assert::IsFalse(registry.IsValid(destroyed));
+			Assert::AreEqual((size_t)1, registry.GetComponentView<Position>().size());
+			Assert::AreEqual(4.f, registry.GetComponent<Position>(kept).x);
+		}
+
+		TEST_METHOD(PlaysBackSeveralBuffers)
+		{
+			Wire::Registry registry;
+			const Wire::EntityId entity = registry.CreateEntity();
+
+			std::vector<Wire::CommandBuffer> buffers(2);
+			buffers[0].AddComponent<Position>(entity, 1.f, 1.f);
+			buffers[1].AddComponent<Velocity>(entity, 2.f);
+			buffers[1].DestroyEntity(entity);
+			buffers[0].DestroyEntity(entity);
+
+			registry.Playback(buffers);
+
+			Assert::IsFalse(registry.IsValid(entity));
+			Assert::IsTrue(registry.GetComponentView<Position>().empty());
+			Assert::IsTrue(registry.GetComponentView<Velocity>().empty());
+		}
+
+		TEST_METHOD(RejectedPlaybackChangesNothing)
+		{
+			Wire::Registry registry;
+			const Wire::EntityId entity = registry.CreateEntity();
+			registry.AddComponent<UnregisteredTagged>(entity, "label");
+
+			const UnregisteredTagged bytes{ "other" };
+			Wire::CommandBuffer buffer;
+			const Wire::CommandBuffer::PendingEntity pending = buffer.CreateEntity();
+			buffer.AddComponent<Position>(pending, 1.f, 2.f);
+			buffer.AddComponent(std::span<const uint8_t>(reinterpret_cast<const uint8_t*>(&bytes), sizeof(bytes)), UnregisteredTagged::comp_guid, pending);
+
+			Assert::ExpectException<std::logic_error>([&]() { registry.Playback(buffer); });
+			Assert::AreEqual((size_t)1, registry.GetAllEntities().size());
+			Assert::IsTrue(registry.GetComponentView<Position>().empty());
+
+			// Data that is not one component is rejected the same way
+			const uint8_t shortData[3] = {};
+			Wire::CommandBuffer sizes;
+			sizes.CreateEntity();
+			sizes.SetComponent<Position>(entity, Position{ 1.f, 1.f });
+			sizes.AddComponent(shortData, Position::comp_guid, entity);
+
+			Assert::ExpectException<std::logic_error>([&]() { registry.Playback(sizes); });
+			Assert::AreEqual((size_t)1, registry.GetAllEntities().size());
+			Assert::AreEqual(std::string("label"), registry.GetComponent<UnregisteredTagged>(entity).label);
+		}
+	};
+}
\ No newline at end of file
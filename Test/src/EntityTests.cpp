@@ -0,0 +1,109 @@
+#include "TestFramework.h"
+#include "TestComponents.h"
+
+#include <Wire/Wire.h>
+
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace WireTests
+{
+	TEST_CLASS(EntityTests)
+	{
+	public:
+		TEST_METHOD(ReusedSlotsGetNewVersions)
+		{
+			Wire::Registry registry;
+			const Wire::EntityId removed = registry.CreateEntity();
+			registry.AddComponent<Position>(removed, 1.f, 2.f);
+			registry.RemoveEntity(removed);
+
+			const Wire::EntityId reused = registry.CreateEntity();
+			Assert::AreEqual(Wire::Entity::GetIndex(removed), Wire::Entity::GetIndex(reused));
+			Assert::IsFalse(registry.IsValid(removed));
+			Assert::IsTrue(registry.IsValid(reused));
+			Assert::IsFalse(registry.HasComponent<Position>(reused));
+		}
+
+		TEST_METHOD(StaleHandlesStayInvalidAfterClear)
+		{
+			Wire::Registry registry;
+			std::vector<Wire::EntityId> entities(100);
+			registry.CreateEntities(entities.size(), entities);
+			registry.RemoveEntity(entities[50]);
+
+			registry.Clear();
+			Assert::IsTrue(registry.GetAllEntities().empty());
+
+			std::vector<Wire::EntityId> recreated(entities.size());
+			registry.CreateEntities(recreated.size(), recreated);
+
+			for (const Wire::EntityId entity : entities)
+			{
+				Assert::IsFalse(registry.IsValid(entity));
+			}
+
+			for (const Wire::EntityId entity : recreated)
+			{
+				Assert::IsTrue(registry.IsValid(entity));
+			}
+
+			// The slots are reused instead of growing the registry
+			Assert::AreEqual((size_t)entities.size(), registry.GetStats().entitySlotCount);
+		}
+
+		TEST_METHOD(RemoveIgnoresInvalidIds)
+		{
+			Wire::Registry registry;
+			const Wire::EntityId parent = registry.CreateEntity();
+			const Wire::EntityId child = registry.CreateEntity();
+			const Wire::EntityId other = registry.CreateEntity();
+			registry.AddChild(parent, child);
+
+			registry.RemoveEntity(parent);
+			registry.RemoveEntity(child);
+			registry.RemoveEntity(parent);
+			registry.RemoveEntity(Wire::NullID);
+
+			Assert::IsFalse(registry.IsValid(child));
+			Assert::IsTrue(registry.IsValid(other));
+			Assert::AreEqual((size_t)1, registry.GetAllEntities().size());
+		}
+
+		TEST_METHOD(MovedFromRegistryIsUsable)
+		{
+			Wire::Registry registry;
+			const Wire::EntityId entity = registry.CreateEntity();
+
+			Wire::Registry target;
+			target = std::move(registry);
+			Assert::IsTrue(target.IsValid(entity));
+
+			const Wire::EntityId created = registry.CreateEntity();
+			Assert::IsTrue(registry.IsValid(created));
+			Assert::IsTrue(created != Wire::NullID);
+		}
+
+		TEST_METHOD(AddEntityRejectsLiveIds)
+		{
+			Wire::Registry registry;
+			const Wire::EntityId entity = registry.CreateEntity();
+			registry.AddComponent<Position>(entity, 1.f, 2.f);
+
+			// A live slot is rejected whatever version the id carries
+			Assert::AreEqual(Wire::NullID, registry.AddEntity(entity));
+			Assert::AreEqual(Wire::NullID, registry.AddEntity(Wire::Entity::Compose(Wire::Entity::GetIndex(entity), 7)));
+			Assert::AreEqual(Wire::NullID, registry.AddEntity(Wire::NullID));
+			Assert::AreEqual((size_t)1, registry.GetAllEntities().size());
+
+			const Wire::EntityId added = Wire::Entity::Compose(10, 3);
+			Assert::AreEqual(added, registry.AddEntity(added));
+
+			registry.RemoveEntity(entity);
+			registry.RemoveEntity(added);
+			Assert::IsTrue(registry.GetAllEntities().empty());
+			Assert::IsFalse(registry.IsValid(entity));
+		}
+	};
+}
\ No newline at end of file
@@ -0,0 +1,93 @@
+#include "TestFramework.h"
+#include "TestComponents.h"
+
+#include <Wire/Wire.h>
+
+#include <stdexcept>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace WireTests
+{
+	TEST_CLASS(GroupTests)
+	{
+	public:
+		TEST_METHOD(GroupedEntitiesArePackedInLockStep)
+		{
+			Wire::Registry registry;
+			std::vector<Wire::EntityId> entities(3000);
+			registry.CreateEntities(entities.size(), entities);
+
+			for (size_t i = 0; i < entities.size(); i++)
+			{
+				registry.AddComponent<Position>(entities[i], (float)i, 0.f);
+				if (i % 3 == 0)
+				{
+					registry.AddComponent<Velocity>(entities[i], (float)i);
+				}
+			}
+
+			// Existing components are packed when the group is created, later ones as they are added and removed
+			registry.CreateGroup<Position, Velocity>();
+			registry.AddComponent<Velocity>(entities[1], 1.f);
+			registry.RemoveComponent<Velocity>(entities[0]);
+			registry.RemoveEntity(entities[3]);
+
+			const std::span<const Wire::EntityId> positions = registry.GetComponentView<Position>();
+			const std::span<const Wire::EntityId> velocities = registry.GetComponentView<Velocity>();
+
+			size_t visited = 0;
+			registry.ForEach<Position, Velocity>([&](Wire::EntityId, Position& position, Velocity& velocity)
+			{
+				Assert::AreEqual(position.x, velocity.dx);
+				visited++;
+			});
+
+			Assert::AreEqual(velocities.size(), visited);
+			for (size_t i = 0; i < velocities.size(); i++)
+			{
+				Assert::AreEqual(velocities[i], positions[i]);
+			}
+		}
+
+		TEST_METHOD(PoolsBelongToOneGroup)
+		{
+			Wire::Registry registry;
+			registry.CreateGroup<Position, Velocity>();
+
+			Assert::ExpectException<std::logic_error>([&]() { registry.CreateGroup<Velocity, Body>(); });
+			Assert::ExpectException<std::logic_error>([&]() { registry.CreateGroup<Body, Body>(); });
+
+			// The first group still packs its entities in lock step
+			std::vector<Wire::EntityId> entities(10);
+			registry.CreateEntities(entities.size(), entities);
+			for (size_t i = 0; i < entities.size(); i++)
+			{
+				registry.AddComponent<Position>(entities[i], (float)i, 0.f);
+				registry.AddComponent<Body>(entities[i], Body{ 1.f, 0.0, 0 });
+			}
+
+			registry.AddComponent<Velocity>(entities[9], 9.f);
+			Assert::AreEqual(entities[9], registry.GetComponentView<Position>()[0]);
+
+			// Body was not taken by either rejected group
+			registry.CreateGroup<Body>();
+		}
+
+		TEST_METHOD(ClonesKeepTheirGroups)
+		{
+			Wire::Registry registry;
+			registry.CreateGroup<Position, Velocity>();
+
+			Wire::Registry clone = registry.Clone();
+			const Wire::EntityId entity = clone.CreateEntity();
+			clone.AddComponent<Velocity>(entity, 2.f);
+			clone.AddComponent<Position>(clone.CreateEntity(), 0.f, 0.f);
+			clone.AddComponent<Position>(entity, 2.f, 0.f);
+
+			Assert::AreEqual(entity, clone.GetComponentView<Position>()[0]);
+			Assert::IsTrue(registry.GetComponentView<Position>().empty());
+		}
+	};
+}
\ No newline at end of file
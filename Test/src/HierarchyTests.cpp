@@ -0,0 +1,111 @@
+#include "TestFramework.h"
+#include "TestComponents.h"
+
+#include <Wire/Wire.h>
+
+#include <algorithm>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace WireTests
+{
+	TEST_CLASS(HierarchyTests)
+	{
+	public:
+		TEST_METHOD(ChildrenKeepTheirOrder)
+		{
+			Wire::Registry registry;
+			const Wire::EntityId parent = registry.CreateEntity();
+			std::vector<Wire::EntityId> children(5);
+			registry.CreateEntities(children.size(), children);
+
+			for (const Wire::EntityId child : children)
+			{
+				registry.AddChild(parent, child);
+			}
+
+			registry.RemoveChild(parent, children[2]);
+			children.erase(children.begin() + 2);
+
+			Assert::IsTrue(registry.GetChildren(parent) == children);
+			Assert::AreEqual(Wire::NullID, registry.GetParent(parent));
+			Assert::AreEqual(parent, registry.GetParent(children[0]));
+			Assert::AreEqual(1u, registry.GetDepth(children[0]));
+		}
+
+		TEST_METHOD(ReparentingUpdatesSubtreeDepth)
+		{
+			Wire::Registry registry;
+			const Wire::EntityId root = registry.CreateEntity();
+			const Wire::EntityId middle = registry.CreateEntity();
+			const Wire::EntityId leaf = registry.CreateEntity();
+			const Wire::EntityId other = registry.CreateEntity();
+
+			registry.AddChild(middle, leaf);
+			registry.AddChild(root, middle);
+			Assert::AreEqual(2u, registry.GetDepth(leaf));
+
+			registry.AddChild(other, root);
+			Assert::AreEqual(3u, registry.GetDepth(leaf));
+
+			registry.RemoveChild(other, root);
+			Assert::AreEqual(0u, registry.GetDepth(root));
+			Assert::AreEqual(2u, registry.GetDepth(leaf));
+			Assert::IsTrue(registry.GetChildren(other).empty());
+		}
+
+		TEST_METHOD(HierarchyOrderVisitsParentsFirst)
+		{
+			Wire::Registry registry;
+			std::vector<Wire::EntityId> entities(8);
+			registry.CreateEntities(entities.size(), entities);
+
+			// Two trees, linked children first so slot order differs from tree order
+			registry.AddChild(entities[5], entities[6]);
+			registry.AddChild(entities[0], entities[5]);
+			registry.AddChild(entities[0], entities[1]);
+			registry.AddChild(entities[7], entities[2]);
+
+			const std::vector<Wire::EntityId> order = registry.GetHierarchyOrder();
+			auto position = [&](Wire::EntityId aId) { return std::find(order.begin(), order.end(), aId) - order.begin(); };
+
+			for (const Wire::EntityId entity : order)
+			{
+				const Wire::EntityId parent = registry.GetParent(entity);
+				if (parent != Wire::NullID)
+				{
+					Assert::IsTrue(position(parent) < position(entity));
+				}
+			}
+
+			Assert::IsTrue(position(entities[6]) < position(entities[1]));
+		}
+
+		TEST_METHOD(RemovingAParentRemovesTheSubtree)
+		{
+			Wire::Registry registry;
+			const Wire::EntityId root = registry.CreateEntity();
+			const Wire::EntityId child = registry.CreateEntity();
+			const Wire::EntityId grandchild = registry.CreateEntity();
+			const Wire::EntityId sibling = registry.CreateEntity();
+
+			registry.AddChild(root, child);
+			registry.AddChild(child, grandchild);
+			registry.AddChild(root, sibling);
+			registry.AddComponent<Position>(grandchild, 1.f, 1.f);
+
+			registry.RemoveEntity(child);
+
+			Assert::IsFalse(registry.IsValid(child));
+			Assert::IsFalse(registry.IsValid(grandchild));
+			Assert::IsTrue(registry.GetComponentView<Position>().empty());
+			Assert::IsTrue(registry.GetChildren(root) == std::vector<Wire::EntityId>{ sibling });
+
+			// A new entity in the reused slot starts outside the hierarchy
+			const Wire::EntityId reused = registry.CreateEntity();
+			Assert::AreEqual(Wire::NullID, registry.GetParent(reused));
+			Assert::IsTrue(registry.GetChildren(reused).empty());
+		}
+	};
+}
\ No newline at end of file
@@ -0,0 +1,91 @@
+#include "TestFramework.h"
+#include "TestComponents.h"
+
+#include <Wire/Wire.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace WireTests
+{
+	TEST_CLASS(JobSystemTests)
+	{
+	public:
+		TEST_METHOD(ParallelForVisitsEveryIndexOnce)
+		{
+			Wire::JobSystem jobSystem(4);
+			std::vector<std::atomic<int>> visits(10000);
+			std::atomic<int> chunks = 0;
+
+			jobSystem.ParallelFor(visits.size(), 64, [&](size_t begin, size_t end)
+			{
+				chunks++;
+				for (size_t i = begin; i < end; i++)
+				{
+					visits[i]++;
+				}
+			});
+
+			Assert::AreEqual((int)((visits.size() + 63) / 64), chunks.load());
+			for (const std::atomic<int>& count : visits)
+			{
+				Assert::AreEqual(1, count.load());
+			}
+		}
+
+		TEST_METHOD(ParallelForRethrowsOnTheCaller)
+		{
+			Wire::JobSystem jobSystem(4);
+
+			Assert::ExpectException<std::runtime_error>([&]()
+			{
+				jobSystem.ParallelFor(1000, 10, [](size_t begin, size_t end)
+				{
+					if (begin <= 500 && 500 < end)
+					{
+						throw std::runtime_error("chunk failed");
+					}
+				});
+			});
+
+			// Every chunk has finished or was skipped, the job system keeps working
+			std::atomic<size_t> sum = 0;
+			jobSystem.ParallelFor(1000, 10, [&](size_t begin, size_t end) { sum += end - begin; });
+			Assert::AreEqual((size_t)1000, sum.load());
+		}
+
+		TEST_METHOD(ParallelForEachWritesComponents)
+		{
+			Wire::JobSystem jobSystem(4);
+			Wire::Registry registry;
+
+			std::vector<Wire::EntityId> entities(5000);
+			registry.CreateEntities(entities.size(), entities);
+			registry.AddComponents<Position>(entities, Position{ 0.f, 0.f });
+
+			for (size_t i = 0; i < entities.size(); i += 2)
+			{
+				registry.AddComponent<Velocity>(entities[i], (float)i);
+			}
+
+			std::atomic<size_t> visited = 0;
+			registry.ParallelForEach<Position, const Velocity>([&](Wire::EntityId, Position& position, const Velocity& velocity)
+			{
+				position.x += velocity.dx;
+				position.y += 1.f;
+				visited++;
+			}, jobSystem, 128);
+
+			Assert::AreEqual(entities.size() / 2, visited.load());
+			for (size_t i = 0; i < entities.size(); i++)
+			{
+				const Position& position = registry.GetComponent<const Position>(entities[i]);
+				Assert::AreEqual(i % 2 ? 0.f : (float)i, position.x);
+				Assert::AreEqual(i % 2 ? 0.f : 1.f, position.y);
+			}
+		}
+	};
+}
\ No newline at end of file
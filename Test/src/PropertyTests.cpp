@@ -0,0 +1,100 @@
+#include "TestFramework.h"
+#include "TestComponents.h"
+
+#include <Wire/Wire.h>
+
+#include <stdexcept>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace WireTests
+{
+	TEST_CLASS(PropertyTests)
+	{
+	public:
+		TEST_METHOD(RoundTripsByName)
+		{
+			Wire::Registry registry;
+			const Wire::EntityId entity = registry.CreateEntity();
+			registry.AddComponent<Body>(entity, Body{ 1.f, 2.0, 3 });
+
+			const uint64_t energy = Wire::ComponentRegistry::HashPropertyName("Energy");
+			registry.SetProperty<double>(entity, Body::comp_guid, energy, 5.0);
+			registry.SetProperty<int>(entity, Body::comp_guid, Wire::ComponentRegistry::HashPropertyName("Flags"), 7);
+
+			Assert::AreEqual(5.0, registry.GetProperty<double>(entity, Body::comp_guid, energy));
+			Assert::AreEqual(5.0, registry.GetComponent<const Body>(entity).energy);
+			Assert::AreEqual(7, registry.GetComponent<const Body>(entity).flags);
+			Assert::AreEqual(1.f, registry.GetComponent<const Body>(entity).mass);
+		}
+
+		TEST_METHOD(RoundTripsInColumns)
+		{
+			Wire::Registry registry;
+			registry.EnableColumnLayout<Position>();
+
+			std::vector<Wire::EntityId> entities(100);
+			std::vector<Position> positions;
+			registry.CreateEntities(entities.size(), entities);
+			for (size_t i = 0; i < entities.size(); i++)
+			{
+				positions.push_back({ (float)i, 0.f });
+			}
+
+			registry.AddComponents<Position>(entities, std::span<const Position>(positions));
+
+			const Wire::Registry::Property y = registry.FindProperty(Position::comp_guid, Wire::ComponentRegistry::HashPropertyName("Y"));
+			for (size_t i = 0; i < entities.size(); i++)
+			{
+				registry.SetProperty<float>(entities[i], y, (float)i * 2.f);
+			}
+
+			// The neighbouring column is untouched
+			positions = registry.GetAllComponents<Position>();
+			for (size_t i = 0; i < entities.size(); i++)
+			{
+				Assert::AreEqual((float)i * 2.f, registry.GetProperty<float>(entities[i], y));
+				Assert::AreEqual((float)i, positions[i].x);
+				Assert::AreEqual((float)i * 2.f, positions[i].y);
+			}
+		}
+
+		TEST_METHOD(RejectsUnknownNamesAndTypes)
+		{
+			Wire::Registry registry;
+			const Wire::EntityId entity = registry.CreateEntity();
+			registry.AddComponent<Body>(entity, Body{ 1.f, 2.0, 3 });
+
+			Assert::ExpectException<std::logic_error>([&]() { registry.FindProperty(Body::comp_guid, Wire::ComponentRegistry::HashPropertyName("Missing")); });
+
+			// Names are stored with an upper case first letter
+			Assert::ExpectException<std::logic_error>([&]() { registry.FindProperty(Body::comp_guid, Wire::ComponentRegistry::HashPropertyName("energy")); });
+
+			const Wire::Registry::Property energy = registry.FindProperty(Body::comp_guid, Wire::ComponentRegistry::HashPropertyName("Energy"));
+			Assert::ExpectException<std::logic_error>([&]() { registry.GetProperty<float>(entity, energy); });
+			Assert::ExpectException<std::logic_error>([&]() { registry.SetProperty<float>(entity, energy, 1.f); });
+			Assert::AreEqual(2.0, registry.GetComponent<const Body>(entity).energy);
+		}
+
+		TEST_METHOD(SetPropertyMarksChanged)
+		{
+			Wire::Registry registry;
+			registry.EnableChangeTracking<Body>();
+
+			const Wire::EntityId changed = registry.CreateEntity();
+			const Wire::EntityId read = registry.CreateEntity();
+			registry.AddComponent<Body>(changed, Body{ 1.f, 2.0, 3 });
+			registry.AddComponent<Body>(read, Body{ 1.f, 2.0, 3 });
+
+			const uint64_t since = registry.AdvanceTick();
+			const Wire::Registry::Property mass = registry.FindProperty(Body::comp_guid, Wire::ComponentRegistry::HashPropertyName("Mass"));
+			registry.SetProperty<float>(changed, mass, 4.f);
+			Assert::AreEqual(1.f, registry.GetProperty<float>(read, mass));
+
+			std::vector<Wire::EntityId> visited;
+			registry.ForEachChanged<Body>(since, [&](Wire::EntityId id, Body&) { visited.emplace_back(id); });
+			Assert::IsTrue(visited == std::vector<Wire::EntityId>{ changed });
+		}
+	};
+}
\ No newline at end of file
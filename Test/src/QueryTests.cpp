@@ -0,0 +1,84 @@
+#include "TestFramework.h"
+#include "TestComponents.h"
+
+#include <Wire/Wire.h>
+
+#include <algorithm>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace WireTests
+{
+	TEST_CLASS(QueryTests)
+	{
+	public:
+		TEST_METHOD(QueriesFollowComponentChanges)
+		{
+			Wire::Registry registry;
+			std::vector<Wire::EntityId> entities(100);
+			registry.CreateEntities(entities.size(), entities);
+			registry.AddComponents<Position>(entities, Position{ 0.f, 0.f });
+
+			const Wire::Query<Position, Velocity> query = registry.GetQuery<Position, Velocity>();
+			Assert::AreEqual((size_t)0, query.GetSize());
+
+			for (size_t i = 0; i < entities.size(); i += 2)
+			{
+				registry.AddComponent<Velocity>(entities[i], 1.f);
+			}
+
+			registry.RemoveComponent<Position>(entities[0]);
+			registry.RemoveEntity(entities[2]);
+
+			Assert::AreEqual((size_t)48, query.GetSize());
+			Assert::IsFalse(query.Contains(entities[0]));
+			Assert::IsFalse(query.Contains(entities[1]));
+			Assert::IsTrue(query.Contains(entities[4]));
+
+			// The same types share one cache
+			Assert::AreEqual((size_t)48, registry.GetQuery<Position, Velocity>().GetSize());
+		}
+
+		TEST_METHOD(ForEachCanRemoveTheCurrentEntity)
+		{
+			Wire::Registry registry;
+			for (int i = 0; i < 50; i++)
+			{
+				const Wire::EntityId entity = registry.CreateEntity();
+				registry.AddComponent<Position>(entity, (float)i, 0.f);
+				registry.AddComponent<Velocity>(entity, 1.f);
+			}
+
+			int visited = 0;
+			registry.GetQuery<Position, const Velocity>().ForEach([&](Wire::EntityId id, Position& position, const Velocity& velocity)
+			{
+				position.x += velocity.dx;
+				visited++;
+
+				if (visited % 2)
+				{
+					registry.RemoveComponent<Velocity>(id);
+				}
+			});
+
+			Assert::AreEqual(50, visited);
+			Assert::AreEqual((size_t)25, registry.GetQuery<Position, Velocity>().GetSize());
+		}
+
+		TEST_METHOD(ClonesKeepTheirQueries)
+		{
+			Wire::Registry registry;
+			const Wire::EntityId entity = registry.CreateEntity();
+			registry.AddComponent<Position>(entity, 0.f, 0.f);
+			registry.AddComponent<Velocity>(entity, 0.f);
+			registry.GetQuery<Position, Velocity>();
+
+			Wire::Registry clone = registry.Clone();
+			clone.RemoveComponent<Velocity>(entity);
+
+			Assert::AreEqual((size_t)0, clone.GetQuery<Position, Velocity>().GetSize());
+			Assert::AreEqual((size_t)1, registry.GetQuery<Position, Velocity>().GetSize());
+		}
+	};
+}
\ No newline at end of file
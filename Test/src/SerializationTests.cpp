@@ -0,0 +1,276 @@
+#include "TestFramework.h"
+#include "TestComponents.h"
+
+#include <Wire/Wire.h>
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace WireTests
+{
+	// The same component before and after a layout change, a saved pool is moved from one to the other by rewriting its GUID
+	SERIALIZE_COMPONENT(struct SavedLayout
+	{
+		CREATE_COMPONENT_GUID("{1D4B7A60-2C4E-4F0B-9F3A-6E2D1C0B5A10}"_guid);
+		int health;
+		float speed;
+		double dropped;
+		uint32_t count;
+	}, SavedLayout);
+
+	SERIALIZE_COMPONENT(struct ChangedLayout
+	{
+		CREATE_COMPONENT_GUID("{1D4B7A60-2C4E-4F0B-9F3A-6E2D1C0B5A11}"_guid);
+		float speed;
+		double health;
+		int armor;
+		bool count;
+	}, ChangedLayout);
+
+	static void ReplaceGUID(const std::filesystem::path& aPath, const WireGUID& aFrom, const WireGUID& aTo)
+	{
+		std::vector<char> data;
+		{
+			std::ifstream file(aPath, std::ios::binary);
+			data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+		}
+
+		const char* from = reinterpret_cast<const char*>(&aFrom);
+		auto it = std::search(data.begin(), data.end(), from, from + sizeof(WireGUID));
+		Assert::IsTrue(it != data.end());
+		memcpy(&*it, &aTo, sizeof(WireGUID));
+
+		std::ofstream file(aPath, std::ios::binary);
+		file.write(data.data(), data.size());
+	}
+
+	TEST_CLASS(SerializationTests)
+	{
+	public:
+
+		TEST_METHOD(RegistryRoundTrip)
+		{
+			Wire::Registry registry;
+			std::vector<Wire::EntityId> entities;
+			for (int i = 0; i < 5000; i++)
+			{
+				entities.push_back(registry.CreateEntity());
+				registry.AddComponent<Position>(entities.back(), (float)i, 1.f);
+				if (i % 7 == 0)
+				{
+					registry.AddComponent<Velocity>(entities.back(), (float)i);
+				}
+			}
+
+			for (int i = 0; i < 5000; i += 11)
+			{
+				registry.RemoveEntity(entities[i]);
+			}
+
+			const std::filesystem::path path = std::filesystem::temp_directory_path() / "WireTests" / "RoundTrip.wreg";
+			Wire::Serializer::SerializeRegistry(registry, path);
+
+			Wire::Registry loaded;
+			Assert::IsTrue(Wire::Serializer::DeserializeRegistry(path, loaded));
+			Assert::AreEqual(registry.GetAllEntities().size(), loaded.GetAllEntities().size());
+
+			for (int i = 0; i < 5000; i++)
+			{
+				Assert::AreEqual(registry.IsValid(entities[i]), loaded.IsValid(entities[i]));
+				Assert::AreEqual(registry.HasComponent<Velocity>(entities[i]), loaded.HasComponent<Velocity>(entities[i]));
+				if (registry.IsValid(entities[i]))
+				{
+					Assert::AreEqual((float)i, loaded.GetComponent<Position>(entities[i]).x);
+				}
+			}
+		}
+
+		TEST_METHOD(MigratesChangedLayouts)
+		{
+			Wire::Registry registry;
+			std::vector<Wire::EntityId> entities(3000);
+			registry.CreateEntities(entities.size(), entities);
+
+			for (size_t i = 0; i < entities.size(); i++)
+			{
+				registry.AddComponent<SavedLayout>(entities[i], SavedLayout{ (int)i, 0.5f, 1.0, (uint32_t)(i % 2) });
+			}
+
+			const std::filesystem::path folder = std::filesystem::temp_directory_path() / "WireTests" / "Migration";
+			std::filesystem::remove_all(folder);
+			Wire::Serializer::SerializeRegistry(registry, folder / "Scene.wreg");
+			Wire::Serializer::SerializeEntityToFile(entities[3], registry, folder);
+
+			ReplaceGUID(folder / "Scene.wreg", SavedLayout::comp_guid, ChangedLayout::comp_guid);
+			const std::filesystem::path entityFile = folder / ("Entity_" + std::to_string(entities[3]) + ".ent");
+			ReplaceGUID(entityFile, SavedLayout::comp_guid, ChangedLayout::comp_guid);
+
+			// Properties are matched by name, numbers are converted and new properties start at zero
+			Wire::Registry loaded;
+			Assert::IsTrue(Wire::Serializer::DeserializeRegistry(folder / "Scene.wreg", loaded));
+			Assert::IsFalse(loaded.HasComponent<SavedLayout>(entities[0]));
+
+			for (size_t i = 0; i < entities.size(); i++)
+			{
+				const ChangedLayout& component = loaded.GetComponent<const ChangedLayout>(entities[i]);
+				Assert::AreEqual(0.5f, component.speed);
+				Assert::AreEqual((double)i, component.health);
+				Assert::AreEqual(0, component.armor);
+				Assert::AreEqual(i % 2 == 1, component.count);
+			}
+
+			Wire::Registry fromEntity;
+			Assert::AreEqual(entities[3], Wire::Serializer::DeserializeEntityToRegistry(entityFile, fromEntity));
+			Assert::AreEqual(3.0, fromEntity.GetComponent<const ChangedLayout>(entities[3]).health);
+			Assert::IsTrue(fromEntity.GetComponent<const ChangedLayout>(entities[3]).count);
+		}
+
+		TEST_METHOD(SceneFolderRoundTrip)
+		{
+			Wire::Registry registry;
+			std::vector<Wire::EntityId> entities(300);
+			registry.CreateEntities(entities.size(), entities);
+
+			const std::filesystem::path folder = std::filesystem::temp_directory_path() / "WireTests" / "SceneFolder";
+			std::filesystem::remove_all(folder);
+
+			for (size_t i = 0; i < entities.size(); i++)
+			{
+				registry.AddComponent<Position>(entities[i], (float)i, 2.f);
+				if (i % 3 == 0)
+				{
+					registry.AddComponent<Velocity>(entities[i], (float)i);
+				}
+
+				Wire::Serializer::SerializeEntityToFile(entities[i], registry, folder);
+			}
+
+			// Cut inside the Position data, the file is dropped rather than loaded with a partial component
+			const Wire::EntityId truncated = registry.CreateEntity();
+			registry.AddComponent<Position>(truncated, 1.f, 1.f);
+			Wire::Serializer::SerializeEntityToFile(truncated, registry, folder);
+
+			const std::filesystem::path truncatedFile = folder / ("Entity_" + std::to_string(truncated) + ".ent");
+			std::filesystem::resize_file(truncatedFile, std::filesystem::file_size(truncatedFile) - 2);
+
+			// More files than fit in one chunk, so several workers decode into their own staging buffers
+			Wire::JobSystem jobSystem(4);
+			Wire::Registry loaded;
+			std::vector<Wire::EntityId> loadedEntities = Wire::Serializer::DeserializeSceneFolder(folder, loaded, jobSystem);
+
+			std::sort(loadedEntities.begin(), loadedEntities.end());
+			Assert::IsTrue(std::equal(entities.begin(), entities.end(), loadedEntities.begin(), loadedEntities.end()));
+			Assert::AreEqual(entities.size(), loaded.GetAllEntities().size());
+			Assert::IsFalse(loaded.IsValid(truncated));
+
+			for (size_t i = 0; i < entities.size(); i++)
+			{
+				Assert::AreEqual((float)i, loaded.GetComponent<Position>(entities[i]).x);
+				Assert::AreEqual(2.f, loaded.GetComponent<Position>(entities[i]).y);
+				Assert::AreEqual(i % 3 == 0, loaded.HasComponent<Velocity>(entities[i]));
+				if (i % 3 == 0)
+				{
+					Assert::AreEqual((float)i, loaded.GetComponent<Velocity>(entities[i]).dx);
+				}
+			}
+
+			Assert::AreEqual(Wire::NullID, Wire::Serializer::DeserializeEntityToRegistry(truncatedFile, loaded));
+		}
+
+		TEST_METHOD(LiveIdsAreNotLoadedTwice)
+		{
+			Wire::Registry registry;
+			const Wire::EntityId entity = registry.CreateEntity();
+			registry.AddComponent<Position>(entity, 1.f, 2.f);
+
+			const std::filesystem::path folder = std::filesystem::temp_directory_path() / "WireTests" / "LiveIds";
+			std::filesystem::remove_all(folder);
+			Wire::Serializer::SerializeEntityToFile(entity, registry, folder);
+			Wire::Serializer::SerializeRegistry(registry, folder / "Scene.wreg");
+
+			// A second file with the same id must not add another Position to the entity
+			const std::filesystem::path entityFile = folder / ("Entity_" + std::to_string(entity) + ".ent");
+			std::filesystem::copy_file(entityFile, folder / "Copy.ent");
+
+			Wire::Registry loaded;
+			Assert::AreEqual((size_t)1, Wire::Serializer::DeserializeSceneFolder(folder, loaded).size());
+			Assert::AreEqual((size_t)1, loaded.GetAllEntities().size());
+			Assert::AreEqual((size_t)1, loaded.GetPools().at(Position::comp_guid).GetComponentView().size());
+
+			Assert::AreEqual(Wire::NullID, Wire::Serializer::DeserializeEntityToRegistry(entityFile, loaded));
+			Assert::IsFalse(Wire::Serializer::DeserializeRegistry(folder / "Scene.wreg", loaded));
+			Assert::AreEqual((size_t)1, loaded.GetPools().at(Position::comp_guid).GetComponentView().size());
+
+			loaded.RemoveEntity(entity);
+			Assert::IsTrue(loaded.GetAllEntities().empty());
+		}
+
+		TEST_METHOD(ComponentsWithOpsAreNotSaved)
+		{
+			Wire::Registry registry;
+			const Wire::EntityId entity = registry.CreateEntity();
+			registry.AddComponent<Position>(entity, 4.f, 5.f);
+			registry.AddComponent<Tagged>(entity, 1, std::string(64, 'x'));
+
+			const std::filesystem::path folder = std::filesystem::temp_directory_path() / "WireTests" / "OpsScene";
+			std::filesystem::remove_all(folder);
+			Wire::Serializer::SerializeEntityToFile(entity, registry, folder);
+			Wire::Serializer::SerializeRegistry(registry, folder / "Scene.wreg");
+
+			Wire::Registry fromEntity;
+			Assert::AreEqual(entity, Wire::Serializer::DeserializeEntityToRegistry(folder / ("Entity_" + std::to_string(entity) + ".ent"), fromEntity));
+			Assert::AreEqual(5.f, fromEntity.GetComponent<Position>(entity).y);
+			Assert::IsFalse(fromEntity.HasComponent<Tagged>(entity));
+
+			Wire::Registry fromRegistry;
+			Assert::IsTrue(Wire::Serializer::DeserializeRegistry(folder / "Scene.wreg", fromRegistry));
+			Assert::AreEqual(5.f, fromRegistry.GetComponent<Position>(entity).y);
+			Assert::IsFalse(fromRegistry.HasComponent<Tagged>(entity));
+		}
+
+		TEST_METHOD(RawBytesWithOpsThrow)
+		{
+			Wire::Registry registry;
+			const Wire::EntityId entity = registry.CreateEntity();
+			registry.AddComponent<Tagged>(entity, 1, "label");
+
+			const Tagged tagged{ 2, "other" };
+			const std::span<const uint8_t> bytes(reinterpret_cast<const uint8_t*>(&tagged), sizeof(Tagged));
+
+			Assert::ExpectException<std::logic_error>([&]() { registry.AddComponent(bytes, Tagged::comp_guid, registry.CreateEntity()); });
+			Assert::ExpectException<std::logic_error>([&]() { registry.SetComponentData(bytes, Tagged::comp_guid, entity); });
+
+			Wire::CommandBuffer buffer;
+			Assert::ExpectException<std::logic_error>([&]() { buffer.AddComponent(bytes, Tagged::comp_guid, entity); });
+			Assert::ExpectException<std::logic_error>([&]() { buffer.SetComponent(bytes, Tagged::comp_guid, entity); });
+
+			Assert::IsTrue(buffer.IsEmpty());
+			Assert::AreEqual(std::string("label"), registry.GetComponent<Tagged>(entity).label);
+		}
+
+		TEST_METHOD(DeltasSkipComponentsWithOps)
+		{
+			Wire::Registry registry;
+			const Wire::EntityId entity = registry.CreateEntity();
+			registry.AddComponent<Position>(entity, 1.f, 1.f);
+
+			Wire::Registry replica = registry;
+			const Wire::Snapshot previous(registry);
+
+			registry.AddComponent<Tagged>(entity, 3, "label");
+			registry.GetComponent<Position>(entity).x = 2.f;
+
+			const std::vector<uint8_t> delta = Wire::DeltaSerializer::CreateDelta(previous, Wire::Snapshot(registry));
+			Assert::IsTrue(Wire::DeltaSerializer::ApplyDelta(delta, replica));
+			Assert::AreEqual(2.f, replica.GetComponent<Position>(entity).x);
+			Assert::IsFalse(replica.HasComponent<Tagged>(entity));
+		}
+	};
+}
\ No newline at end of file
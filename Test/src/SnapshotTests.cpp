@@ -0,0 +1,102 @@
+#include "TestFramework.h"
+#include "TestComponents.h"
+
+#include <Wire/Wire.h>
+
+#include <cstddef>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace WireTests
+{
+	TEST_CLASS(SnapshotTests)
+	{
+	public:
+		TEST_METHOD(UnchangedWorldGivesEmptyDelta)
+		{
+			Wire::Registry registry;
+			std::vector<Wire::EntityId> entities(5000);
+			registry.CreateEntities(entities.size(), entities);
+			registry.AddComponents<Position>(entities, Position{ 1.f, 2.f });
+
+			const Wire::Snapshot previous(registry);
+
+			// Magic and the destroyed, created and pool counts
+			const std::vector<uint8_t> delta = Wire::DeltaSerializer::CreateDelta(previous, Wire::Snapshot(registry));
+			Assert::AreEqual((size_t)16, delta.size());
+		}
+
+		TEST_METHOD(DeltaReplaysChanges)
+		{
+			// Several component and slot pages, so shared and copied pages are mixed
+			Wire::Registry registry;
+			std::vector<Wire::EntityId> entities(5000);
+			registry.CreateEntities(entities.size(), entities);
+			registry.AddComponents<Position>(entities, Position{ 1.f, 2.f });
+
+			for (size_t i = 0; i < entities.size(); i += 2)
+			{
+				registry.AddComponent<Velocity>(entities[i], (float)i);
+			}
+
+			Wire::Registry replica = registry;
+			const Wire::Snapshot previous(registry);
+
+			registry.GetComponent<Position>(entities[10]).x = 5.f;
+			registry.GetComponent<Position>(entities[4500]).y = 6.f;
+			registry.RemoveComponent<Velocity>(entities[20]);
+			registry.AddComponent<Velocity>(entities[21], 7.f);
+			registry.RemoveEntity(entities[3000]);
+
+			const Wire::EntityId created = registry.CreateEntity();
+			registry.AddComponent<Position>(created, 8.f, 9.f);
+
+			const std::vector<uint8_t> delta = Wire::DeltaSerializer::CreateDelta(previous, Wire::Snapshot(registry));
+			Assert::IsTrue(Wire::DeltaSerializer::ApplyDelta(delta, replica));
+
+			Assert::AreEqual(registry.GetAllEntities().size(), replica.GetAllEntities().size());
+			Assert::IsFalse(replica.IsValid(entities[3000]));
+
+			for (const Wire::EntityId entity : registry.GetAllEntities())
+			{
+				Assert::IsTrue(replica.IsValid(entity));
+				Assert::AreEqual(registry.GetComponent<const Position>(entity).x, replica.GetComponent<const Position>(entity).x);
+				Assert::AreEqual(registry.GetComponent<const Position>(entity).y, replica.GetComponent<const Position>(entity).y);
+				Assert::AreEqual(registry.HasComponent<Velocity>(entity), replica.HasComponent<Velocity>(entity));
+			}
+
+			Assert::AreEqual(7.f, replica.GetComponent<const Velocity>(entities[21]).dx);
+		}
+
+		TEST_METHOD(PaddingIsNotSent)
+		{
+			Wire::Registry registry;
+			const Wire::EntityId entity = registry.CreateEntity();
+			registry.AddComponent<Body>(entity, Body{ 1.f, 2.0, 3 });
+
+			const Wire::Snapshot previous(registry);
+			const std::vector<uint8_t> unchanged = Wire::DeltaSerializer::CreateDelta(previous, Wire::Snapshot(registry));
+
+			// Same values with different padding bytes
+			std::vector<uint8_t> data = registry.GetComponents(entity).at(Body::comp_guid);
+			data[offsetof(Body, mass) + sizeof(float)] = 0xAB;
+			data[sizeof(Body) - 1] = 0xCD;
+			registry.SetComponentData(data, Body::comp_guid, entity);
+
+			Assert::AreEqual(unchanged.size(), Wire::DeltaSerializer::CreateDelta(previous, Wire::Snapshot(registry)).size());
+
+			// Only the changed byte of energy is sent, 2.0 and 4.0 differ in one exponent byte, the padding still differs
+			registry.GetComponent<Body>(entity).energy = 4.0;
+
+			Wire::Registry replica;
+			replica.AddEntity(entity);
+			replica.AddComponent<Body>(entity, Body{ 1.f, 2.0, 3 });
+
+			const std::vector<uint8_t> delta = Wire::DeltaSerializer::CreateDelta(previous, Wire::Snapshot(registry));
+			Assert::AreEqual(unchanged.size() + sizeof(WireGUID) + 4 * sizeof(uint32_t) + sizeof(Wire::EntityId) + 3 * sizeof(uint32_t) + 1, delta.size());
+			Assert::IsTrue(Wire::DeltaSerializer::ApplyDelta(delta, replica));
+			Assert::AreEqual(4.0, replica.GetComponent<const Body>(entity).energy);
+		}
+	};
+}
\ No newline at end of file
@@ -0,0 +1,126 @@
+#include "TestFramework.h"
+#include "TestComponents.h"
+
+#include <Wire/Wire.h>
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace WireTests
+{
+	static const Wire::PoolStats& FindPoolStats(const Wire::RegistryStats& aStats, const WireGUID& aGuid)
+	{
+		for (const Wire::PoolStats& pool : aStats.pools)
+		{
+			if (pool.guid == aGuid)
+			{
+				return pool;
+			}
+		}
+
+		Assert::Fail(L"The pool is missing from the stats");
+		return aStats.pools.front();
+	}
+
+	TEST_CLASS(StatsTests)
+	{
+	public:
+		TEST_METHOD(ReportsOccupancy)
+		{
+			Wire::Registry registry;
+			std::vector<Wire::EntityId> entities(10);
+			registry.CreateEntities(entities.size(), entities);
+			for (const Wire::EntityId entity : entities)
+			{
+				registry.AddComponent<Position>(entity, 0.f, 0.f);
+			}
+
+			registry.RemoveEntity(entities[0]);
+
+			const Wire::RegistryStats stats = registry.GetStats();
+			Assert::AreEqual((size_t)9, stats.entityCount);
+			Assert::AreEqual((size_t)10, stats.entitySlotCount);
+			Assert::AreEqual((size_t)1, stats.freeSlotCount);
+
+			const Wire::PoolStats& pool = FindPoolStats(stats, Position::comp_guid);
+			Assert::AreEqual((size_t)9, pool.componentCount);
+			Assert::AreEqual(sizeof(Position), pool.componentSize);
+			Assert::IsTrue(pool.bytesUsed <= pool.bytesReserved);
+		}
+
+		TEST_METHOD(TraceWritesPoolCounters)
+		{
+			Wire::Registry registry;
+			registry.AddComponent<Position>(registry.CreateEntity(), 0.f, 0.f);
+
+			Wire::Trace::Clear();
+			Wire::Trace::Start();
+			registry.ForEach<Position>([](Wire::EntityId, Position&) {});
+			Wire::Trace::RecordStats(registry.GetStats());
+			Wire::Trace::Stop();
+
+			const std::filesystem::path path = std::filesystem::temp_directory_path() / "WireTests" / "Trace.json";
+			std::filesystem::create_directories(path.parent_path());
+			Assert::IsTrue(Wire::Trace::WriteChromeTrace(path));
+			Wire::Trace::Clear();
+
+			std::ifstream file(path);
+			const std::string json((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+			Assert::IsTrue(json.starts_with("{\"traceEvents\":["));
+			Assert::IsTrue(json.find("{\"name\":\"Registry\",\"ph\":\"C\"") != std::string::npos);
+			Assert::IsTrue(json.find("{\"name\":\"Position\",\"ph\":\"C\"") != std::string::npos);
+			Assert::IsTrue(json.find("\"components\":1,") != std::string::npos);
+
+			// Scopes are only recorded when the library counts
+#ifdef WIRE_ENABLE_STATS
+			Assert::IsTrue(json.find("{\"name\":\"ForEach\",\"ph\":\"X\"") != std::string::npos);
+#else
+			Assert::IsTrue(json.find("\"ph\":\"X\"") == std::string::npos);
+#endif
+		}
+
+#ifdef WIRE_ENABLE_STATS
+		// Only built when the library and the tests define WIRE_ENABLE_STATS
+		TEST_METHOD(CountsPoolOperations)
+		{
+			Wire::Registry registry;
+			std::vector<Wire::EntityId> entities(10);
+			registry.CreateEntities(entities.size(), entities);
+			for (const Wire::EntityId entity : entities)
+			{
+				registry.AddComponent<Position>(entity, 0.f, 0.f);
+			}
+
+			for (size_t i = 0; i < 3; i++)
+			{
+				registry.RemoveComponent<Position>(entities[i]);
+			}
+
+			for (size_t i = 5; i < 9; i++)
+			{
+				registry.GetComponent<Position>(entities[i]).x = 1.f;
+			}
+
+			registry.RemoveEntity(entities[9]);
+			registry.ForEach<Position>([](Wire::EntityId, Position&) {});
+
+			const Wire::RegistryStats stats = registry.GetStats();
+			Assert::AreEqual((uint64_t)10, stats.createCount);
+			Assert::AreEqual((uint64_t)1, stats.destroyCount);
+			Assert::AreEqual((uint64_t)1, stats.forEachCount);
+
+			const Wire::PoolStats& pool = FindPoolStats(stats, Position::comp_guid);
+			Assert::AreEqual((uint64_t)10, pool.addCount);
+			Assert::AreEqual((uint64_t)4, pool.removeCount);
+			Assert::AreEqual((uint64_t)4, pool.getCount);
+			Assert::AreEqual((size_t)6, pool.componentCount);
+		}
+#endif
+	};
+}
\ No newline at end of file
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <Wire/Wire.h>
+
+#include <string>
+
+namespace WireTests
+{
+	SERIALIZE_COMPONENT(struct Position
+	{
+		CREATE_COMPONENT_GUID("{1D4B7A60-2C4E-4F0B-9F3A-6E2D1C0B5A01}"_guid);
+		float x;
+		float y;
+	}, Position);
+
+	SERIALIZE_COMPONENT(struct Velocity
+	{
+		CREATE_COMPONENT_GUID("{1D4B7A60-2C4E-4F0B-9F3A-6E2D1C0B5A02}"_guid);
+		float dx;
+	}, Velocity);
+
+	// Padded between mass and energy and after flags
+	SERIALIZE_COMPONENT(struct Body
+	{
+		CREATE_COMPONENT_GUID("{1D4B7A60-2C4E-4F0B-9F3A-6E2D1C0B5A03}"_guid);
+		float mass;
+		double energy;
+		int flags;
+	}, Body);
+
+	// Not trivially copyable, the pool keeps ComponentOps for it
+	SERIALIZE_COMPONENT(struct Tagged
+	{
+		CREATE_COMPONENT_GUID("{1D4B7A60-2C4E-4F0B-9F3A-6E2D1C0B5A04}"_guid);
+		int id;
+		std::string label;
+	}, Tagged);
+
+	SERIALIZE_COMPONENT(struct alignas(128) Wide
+	{
+		CREATE_COMPONENT_GUID("{1D4B7A60-2C4E-4F0B-9F3A-6E2D1C0B5A05}"_guid);
+		float values[8];
+	}, Wide);
+}
\ No newline at end of file
@@ -0,0 +1,128 @@
+#pragma once
+
+/*
+* The tests are written against the MSVC unit test framework. Other platforms get a minimal stand-in with the same
+* TEST_CLASS, TEST_METHOD and Assert interface, the test project is then built as an executable running every method.
+*/
+#ifdef _WIN32
+
+#include "CppUnitTest.h"
+
+#else
+
+#include <cstdio>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace WireTest
+{
+	struct TestMethod
+	{
+		const char* className;
+		const char* methodName;
+		void(*function)();
+	};
+
+	inline std::vector<TestMethod>& GetTestMethods()
+	{
+		static std::vector<TestMethod> methods;
+		return methods;
+	}
+
+	struct TestRegistrar
+	{
+		TestRegistrar(const char* aClassName, const char* aMethodName, void(*aFunction)())
+		{
+			GetTestMethods().push_back({ aClassName, aMethodName, aFunction });
+		}
+	};
+
+	template<typename T, typename Name>
+	struct TestClass
+	{
+		using Self = T;
+		static constexpr const char* ClassName = Name::value;
+	};
+
+	class AssertFailed : public std::runtime_error
+	{
+	public:
+		using std::runtime_error::runtime_error;
+	};
+}
+
+#define TEST_CLASS(className) \
+	struct className##Name { static constexpr const char* value = #className; }; \
+	class className : public ::WireTest::TestClass<className, className##Name>
+
+#define TEST_METHOD(methodName) \
+	static void methodName##Run() { Self().methodName(); } \
+	static inline const ::WireTest::TestRegistrar methodName##Registrar{ ClassName, #methodName, &methodName##Run }; \
+	void methodName()
+
+namespace Microsoft::VisualStudio::CppUnitTestFramework
+{
+	class Assert
+	{
+	public:
+		static void IsTrue(bool aCondition, const wchar_t* aMessage = nullptr)
+		{
+			if (!aCondition)
+			{
+				Fail(aMessage ? aMessage : L"Assert::IsTrue failed");
+			}
+		}
+
+		static void IsFalse(bool aCondition, const wchar_t* aMessage = nullptr)
+		{
+			IsTrue(!aCondition, aMessage ? aMessage : L"Assert::IsFalse failed");
+		}
+
+		template<typename T>
+		static void AreEqual(const T& aExpected, const T& aActual, const wchar_t* aMessage = nullptr)
+		{
+			if (!(aExpected == aActual))
+			{
+				std::ostringstream stream;
+				stream << "Assert::AreEqual failed, expected " << aExpected << " but was " << aActual;
+				throw ::WireTest::AssertFailed(stream.str() + (aMessage ? " " + Narrow(aMessage) : ""));
+			}
+		}
+
+		template<typename E, typename F>
+		static void ExpectException(F aFunctor, const wchar_t* aMessage = nullptr)
+		{
+			try
+			{
+				aFunctor();
+			}
+			catch (const E&)
+			{
+				return;
+			}
+
+			Fail(aMessage ? aMessage : L"Assert::ExpectException failed, nothing was thrown");
+		}
+
+		[[noreturn]] static void Fail(const wchar_t* aMessage)
+		{
+			throw ::WireTest::AssertFailed(Narrow(aMessage));
+		}
+
+	private:
+		static std::string Narrow(const wchar_t* aMessage)
+		{
+			std::string result;
+			for (; *aMessage; aMessage++)
+			{
+				result += (char)*aMessage;
+			}
+
+			return result;
+		}
+	};
+}
+
+#endif
\ No newline at end of file
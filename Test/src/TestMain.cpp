@@ -0,0 +1,36 @@
+#ifndef _WIN32
+
+#include "TestFramework.h"
+
+int main(int argc, char** argv)
+{
+	// An argument runs only the tests whose Class::Method name contains it
+	const std::string filter = argc > 1 ? argv[1] : "";
+
+	size_t run = 0;
+	size_t failed = 0;
+
+	for (const WireTest::TestMethod& method : WireTest::GetTestMethods())
+	{
+		if ((std::string(method.className) + "::" + method.methodName).find(filter) == std::string::npos)
+		{
+			continue;
+		}
+
+		run++;
+		try
+		{
+			method.function();
+		}
+		catch (const std::exception& exception)
+		{
+			failed++;
+			printf("FAILED %s::%s: %s\n", method.className, method.methodName, exception.what());
+		}
+	}
+
+	printf("%zu tests, %zu failed\n", run, failed);
+	return failed == 0 ? 0 : 1;
+}
+
+#endif
\ No newline at end of file
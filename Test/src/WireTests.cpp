@@ -1,16 +1,150 @@
-#include "CppUnitTest.h"
+#include "TestFramework.h"
+#include "TestComponents.h"
 
+#include <Wire/Wire.h>
+
+#include <atomic>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <vector>
 
 using namespace Microsoft::VisualStudio::CppUnitTestFramework;
 
-namespace OhmTest
+namespace WireTests
 {
-	TEST_CLASS(OhmTest)
+	TEST_CLASS(RegistryTests)
 	{
 	public:
 
-		TEST_METHOD(TestMethod1)
+		TEST_METHOD(AddGetRemove)
+		{
+			Wire::Registry registry;
+			std::vector<Wire::EntityId> entities;
+
+			for (int i = 0; i < 1000; i++)
+			{
+				auto entity = registry.CreateEntity();
+				entities.push_back(entity);
+				registry.AddComponent<Position>(entity, (float)i, 0.f);
+			}
+
+			for (int i = 0; i < 1000; i += 2)
+			{
+				registry.RemoveComponent<Position>(entities[i]);
+			}
+
+			for (int i = 0; i < 1000; i++)
+			{
+				Assert::AreEqual(i % 2 == 1, registry.HasComponent<Position>(entities[i]));
+				if (i % 2 == 1)
+				{
+					Assert::AreEqual((float)i, registry.GetComponent<Position>(entities[i]).x);
+				}
+			}
+
+			Assert::AreEqual((size_t)500, registry.GetComponentView<Position>().size());
+		}
+
+		TEST_METHOD(ForEachVisitsIntersection)
+		{
+			Wire::Registry registry;
+			for (int i = 0; i < 100; i++)
+			{
+				auto entity = registry.CreateEntity();
+				registry.AddComponent<Position>(entity, (float)i, 0.f);
+				if (i % 10 == 0)
+				{
+					registry.AddComponent<Velocity>(entity, (float)i);
+				}
+			}
+
+			int count = 0;
+			registry.ForEach<Position, Velocity>([&](Wire::EntityId, Position& position, Velocity& velocity)
+			{
+				Assert::AreEqual(position.x, velocity.dx);
+				count++;
+			});
+
+			Assert::AreEqual(10, count);
+		}
+
+		TEST_METHOD(RemoveDuringForEach)
+		{
+			Wire::Registry registry;
+			for (int i = 0; i < 100; i++)
+			{
+				registry.AddComponent<Position>(registry.CreateEntity(), (float)i, 0.f);
+			}
+
+			int visited = 0;
+			registry.ForEach<Position>([&](Wire::EntityId id, Position& position)
+			{
+				visited++;
+				if ((int)position.x % 2)
+				{
+					registry.RemoveComponent<Position>(id);
+				}
+			});
+
+			Assert::AreEqual(100, visited);
+			Assert::AreEqual((size_t)50, registry.GetComponentView<Position>().size());
+		}
+
+		TEST_METHOD(RawBytesMustBeOneComponent)
+		{
+			Wire::Registry registry;
+			const Wire::EntityId entity = registry.CreateEntity();
+			const Wire::EntityId next = registry.CreateEntity();
+			registry.AddComponent<Position>(entity, 1.f, 2.f);
+			registry.AddComponent<Position>(next, 3.f, 4.f);
+
+			const std::vector<uint8_t> oversized(sizeof(Position) * 2, 0xFF);
+			const std::vector<uint8_t> undersized(sizeof(float), 0xFF);
+
+			Assert::ExpectException<std::logic_error>([&]() { registry.SetComponentData(oversized, Position::comp_guid, entity); });
+			Assert::ExpectException<std::logic_error>([&]() { registry.SetComponentData(undersized, Position::comp_guid, entity); });
+			Assert::ExpectException<std::logic_error>([&]() { registry.AddComponent(oversized, Position::comp_guid, registry.CreateEntity()); });
+
+			// Neither the component nor its neighbour in the page was touched
+			Assert::AreEqual(2.f, registry.GetComponent<Position>(entity).y);
+			Assert::AreEqual(3.f, registry.GetComponent<Position>(next).x);
+			Assert::AreEqual((size_t)2, registry.GetComponentView<Position>().size());
+		}
+
+		TEST_METHOD(ConstLookupsFromThreads)
 		{
+			// A pool created from its GUID only is not in the type cache yet
+			Wire::Registry registry;
+			const Wire::EntityId entity = registry.CreateEntity();
+			const Position position{ 1.f, 2.f };
+			registry.AddComponent(std::span<const uint8_t>((const uint8_t*)&position, sizeof(Position)), Position::comp_guid, entity);
+
+			const Wire::Registry& reader = registry;
+			std::atomic<int> found = 0;
+
+			std::vector<std::thread> threads;
+			for (int i = 0; i < 4; i++)
+			{
+				threads.emplace_back([&]()
+				{
+					for (int j = 0; j < 1000; j++)
+					{
+						if (reader.HasComponent<Position>(entity) && reader.GetComponentView<Position>().size() == 1)
+						{
+							found++;
+						}
+					}
+				});
+			}
+
+			for (std::thread& thread : threads)
+			{
+				thread.join();
+			}
+
+			Assert::AreEqual(4000, found.load());
+			Assert::AreEqual(2.f, registry.GetComponent<Position>(entity).y);
 		}
 	};
 }
\ No newline at end of file
@@ -0,0 +1,96 @@
+#include "Arena.h"
+
+#include <algorithm>
+
+namespace Wire
+{
+	Arena::Arena(size_t aInitialSize, std::pmr::memory_resource* aUpstream)
+		: m_buffer(aInitialSize, aUpstream), m_pools(std::pmr::pool_options{ 0, LargestPooledBlock }, &m_buffer)
+	{
+	}
+
+	void Arena::Reset()
+	{
+		m_pools.release();
+		m_buffer.Rewind();
+		m_bytesInUse = 0;
+	}
+
+	void Arena::Release()
+	{
+		m_pools.release();
+		m_buffer.Free();
+		m_bytesInUse = 0;
+	}
+
+	void* Arena::do_allocate(size_t aBytes, size_t aAlignment)
+	{
+		m_bytesInUse += aBytes;
+		return m_pools.allocate(aBytes, aAlignment);
+	}
+
+	void Arena::do_deallocate(void* aPointer, size_t aBytes, size_t aAlignment)
+	{
+		m_bytesInUse -= aBytes;
+		m_pools.deallocate(aPointer, aBytes, aAlignment);
+	}
+
+	bool Arena::do_is_equal(const std::pmr::memory_resource& aOther) const noexcept
+	{
+		return this == &aOther;
+	}
+
+	Arena::BlockBuffer::BlockBuffer(size_t aInitialSize, std::pmr::memory_resource* aUpstream)
+		: m_upstream(aUpstream), m_nextSize(std::max(aInitialSize, (size_t)64))
+	{
+	}
+
+	Arena::BlockBuffer::~BlockBuffer()
+	{
+		Free();
+	}
+
+	void Arena::BlockBuffer::Rewind()
+	{
+		m_currentBlock = 0;
+		m_offset = 0;
+	}
+
+	void Arena::BlockBuffer::Free()
+	{
+		for (const Block& block : m_blocks)
+		{
+			m_upstream->deallocate(block.data, block.size, alignof(std::max_align_t));
+		}
+
+		m_blocks.clear();
+		m_bytesReserved = 0;
+		Rewind();
+	}
+
+	void* Arena::BlockBuffer::do_allocate(size_t aBytes, size_t aAlignment)
+	{
+		// Continue in the current block, then in the blocks kept from before the last rewind
+		for (; m_currentBlock < m_blocks.size(); m_currentBlock++, m_offset = 0)
+		{
+			const Block& block = m_blocks[m_currentBlock];
+			const size_t offset = (reinterpret_cast<uintptr_t>(block.data) + m_offset + aAlignment - 1) / aAlignment * aAlignment - reinterpret_cast<uintptr_t>(block.data);
+
+			if (offset + aBytes <= block.size)
+			{
+				m_offset = offset + aBytes;
+				return block.data + offset;
+			}
+		}
+
+		// Room for the allocation at any alignment, blocks are only aligned to max_align_t
+		const size_t size = std::max(m_nextSize, aBytes + aAlignment);
+		m_blocks.emplace_back(Block{ static_cast<std::byte*>(m_upstream->allocate(size, alignof(std::max_align_t))), size });
+		m_bytesReserved += size;
+		m_nextSize = size * 2;
+
+		m_currentBlock = m_blocks.size() - 1;
+		m_offset = 0;
+		return do_allocate(aBytes, aAlignment);
+	}
+}
\ No newline at end of file
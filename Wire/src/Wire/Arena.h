@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+namespace Wire
+{
+	/*
+	* A memory resource for registries that are torn down together, pass it to the Registry constructor.
+	* Freed blocks are pooled by size and reused, the pools take their memory from a list of growing blocks.
+	* The registries still destroy their pools, pages and lists one by one, so tearing a world down is not O(1).
+	* Reset then rewinds the blocks in O(blocks) and keeps them for the next world, Release returns them upstream.
+	* The next world is built without upstream allocations or fresh page faults, which is where the arena saves time.
+	* Not thread safe, like structural changes to a registry.
+	*/
+	class Arena : public std::pmr::memory_resource
+	{
+	public:
+		// aInitialSize is the first block taken from aUpstream, later blocks grow geometrically
+		explicit Arena(size_t aInitialSize = DefaultInitialSize, std::pmr::memory_resource* aUpstream = std::pmr::get_default_resource());
+		Arena(const Arena&) = delete;
+
+		Arena& operator=(const Arena&) = delete;
+
+		// Registries, clones and snapshots using the arena must be destroyed before either call
+		void Reset();
+		void Release();
+
+		inline const size_t GetBytesInUse() const { return m_bytesInUse; }
+		inline const size_t GetBytesReserved() const { return m_buffer.GetBytesReserved(); }
+
+		static constexpr size_t DefaultInitialSize = 1 << 20;
+
+		// Larger allocations are not pooled, their memory is only reused after Reset
+		static constexpr size_t LargestPooledBlock = 1 << 20;
+
+	private:
+		void* do_allocate(size_t aBytes, size_t aAlignment) override;
+		void do_deallocate(void* aPointer, size_t aBytes, size_t aAlignment) override;
+		bool do_is_equal(const std::pmr::memory_resource& aOther) const noexcept override;
+
+		// Bump allocates from its blocks and ignores deallocations
+		class BlockBuffer : public std::pmr::memory_resource
+		{
+		public:
+			BlockBuffer(size_t aInitialSize, std::pmr::memory_resource* aUpstream);
+			~BlockBuffer() override;
+
+			// Starts over in the first block
+			void Rewind();
+			void Free();
+
+			inline const size_t GetBytesReserved() const { return m_bytesReserved; }
+
+		private:
+			void* do_allocate(size_t aBytes, size_t aAlignment) override;
+			void do_deallocate(void*, size_t, size_t) override {}
+			bool do_is_equal(const std::pmr::memory_resource& aOther) const noexcept override { return this == &aOther; }
+
+			struct Block
+			{
+				std::byte* data = nullptr;
+				size_t size = 0;
+			};
+
+			std::pmr::memory_resource* m_upstream;
+			std::vector<Block> m_blocks;
+			size_t m_currentBlock = 0;
+			size_t m_offset = 0;
+			size_t m_nextSize;
+			size_t m_bytesReserved = 0;
+		};
+
+		BlockBuffer m_buffer;
+		std::pmr::unsynchronized_pool_resource m_pools;
+		size_t m_bytesInUse = 0;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,65 @@
+#include "CommandBuffer.h"
+#include "Serialization.h"
+
+#include <cassert>
+#include <stdexcept>
+
+namespace Wire
+{
+	CommandBuffer::PendingEntity CommandBuffer::CreateEntity()
+	{
+		return PendingEntity{ m_pendingEntityCount++ };
+	}
+
+	void CommandBuffer::DestroyEntity(EntityId aId)
+	{
+		Record(CommandType::Destroy, WireGUID::Null(), aId, NullIndex, {});
+	}
+
+	void CommandBuffer::AddComponent(std::span<const uint8_t> data, const WireGUID& guid, EntityId id)
+	{
+		Record(CommandType::Add, guid, id, NullIndex, data);
+	}
+
+	void CommandBuffer::AddComponent(std::span<const uint8_t> data, const WireGUID& guid, PendingEntity aEntity)
+	{
+		assert(aEntity.index < m_pendingEntityCount);
+		Record(CommandType::Add, guid, NullID, aEntity.index, data);
+	}
+
+	void CommandBuffer::RemoveComponent(const WireGUID& guid, EntityId id)
+	{
+		Record(CommandType::Remove, guid, id, NullIndex, {});
+	}
+
+	void CommandBuffer::SetComponent(std::span<const uint8_t> data, const WireGUID& guid, EntityId id)
+	{
+		Record(CommandType::Set, guid, id, NullIndex, data);
+	}
+
+	void CommandBuffer::Clear()
+	{
+		m_commands.clear();
+		m_data.clear();
+		m_pendingEntityCount = 0;
+	}
+
+	void CommandBuffer::Record(CommandType aType, const WireGUID& guid, EntityId aEntity, uint32_t aPendingIndex, std::span<const uint8_t> data)
+	{
+		// A byte copy of a component with ops is not an object the registry could copy construct from
+		if (!data.empty() && ComponentRegistry::GetRegistryDataFromGUID(guid).ops)
+		{
+			throw std::logic_error("Components with ComponentOps can not be recorded as bytes");
+		}
+
+		Command& command = m_commands.emplace_back();
+		command.type = aType;
+		command.entity = aEntity;
+		command.pendingIndex = aPendingIndex;
+		command.guid = guid;
+		command.dataOffset = (uint32_t)m_data.size();
+		command.dataSize = (uint32_t)data.size();
+
+		m_data.insert(m_data.end(), data.begin(), data.end());
+	}
+}
\ No newline at end of file
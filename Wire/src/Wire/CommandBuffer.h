@@ -0,0 +1,123 @@
+#pragma once
+
+#include "Entity.h"
+#include "WireGUID.h"
+
+#include <span>
+#include <vector>
+#include <limits>
+#include <type_traits>
+
+namespace Wire
+{
+	/*
+	* Records structural changes to play them back later with Registry::Playback, for example from inside ForEach.
+	* A buffer is not thread safe, give every thread its own one (see JobSystem::GetCurrentThreadIndex).
+	* Component data is recorded as bytes, so only trivially copyable components can be recorded.
+	* Recording bytes for a registered component with ComponentOps throws std::logic_error.
+	*/
+	class CommandBuffer
+	{
+	public:
+		// Handle to an entity the buffer will create, resolved when the buffer is played back
+		struct PendingEntity
+		{
+			uint32_t index = 0;
+		};
+
+		PendingEntity CreateEntity();
+
+		// Destroys are applied after every other command of the playback
+		void DestroyEntity(EntityId aId);
+
+		// Overwrites the component if the entity already has one
+		void AddComponent(std::span<const uint8_t> data, const WireGUID& guid, EntityId id);
+		void AddComponent(std::span<const uint8_t> data, const WireGUID& guid, PendingEntity aEntity);
+
+		// Skipped if the entity does not have the component at playback
+		void RemoveComponent(const WireGUID& guid, EntityId id);
+		void SetComponent(std::span<const uint8_t> data, const WireGUID& guid, EntityId id);
+
+		template<typename T, typename ... Args>
+		void AddComponent(EntityId aEntity, Args&&... args);
+
+		template<typename T, typename ... Args>
+		void AddComponent(PendingEntity aEntity, Args&&... args);
+
+		template<typename T>
+		void RemoveComponent(EntityId aEntity);
+
+		template<typename T>
+		void SetComponent(EntityId aEntity, const T& aComponent);
+
+		inline const bool IsEmpty() const { return m_commands.empty() && m_pendingEntityCount == 0; }
+		void Clear();
+
+		// The entities created by the last playback, indexed by PendingEntity::index
+		inline const std::vector<EntityId>& GetCreatedEntities() const { return m_createdEntities; }
+		inline const EntityId GetCreatedEntity(PendingEntity aEntity) const { return m_createdEntities[aEntity.index]; }
+
+	private:
+		friend class Registry;
+
+		enum class CommandType : uint8_t
+		{
+			Add,
+			Remove,
+			Set,
+			Destroy
+		};
+
+		struct Command
+		{
+			CommandType type;
+			EntityId entity = NullID;
+			uint32_t pendingIndex = NullIndex;
+			WireGUID guid;
+			uint32_t dataOffset = 0;
+			uint32_t dataSize = 0;
+		};
+
+		static constexpr uint32_t NullIndex = std::numeric_limits<uint32_t>::max();
+
+		void Record(CommandType aType, const WireGUID& guid, EntityId aEntity, uint32_t aPendingIndex, std::span<const uint8_t> data);
+
+		std::vector<Command> m_commands;
+		std::vector<uint8_t> m_data;
+		uint32_t m_pendingEntityCount = 0;
+
+		std::vector<EntityId> m_createdEntities;
+	};
+
+	template<typename T, typename ... Args>
+	inline void CommandBuffer::AddComponent(EntityId aEntity, Args&&... args)
+	{
+		static_assert(std::is_trivially_copyable_v<T>);
+
+		T comp(std::forward<Args>(args)...);
+		AddComponent(std::span<const uint8_t>(reinterpret_cast<const uint8_t*>(&comp), sizeof(T)), T::comp_guid, aEntity);
+	}
+
+	template<typename T, typename ... Args>
+	inline void CommandBuffer::AddComponent(PendingEntity aEntity, Args&&... args)
+	{
+		static_assert(std::is_trivially_copyable_v<T>);
+
+		T comp(std::forward<Args>(args)...);
+		AddComponent(std::span<const uint8_t>(reinterpret_cast<const uint8_t*>(&comp), sizeof(T)), T::comp_guid, aEntity);
+	}
+
+	template<typename T>
+	inline void CommandBuffer::RemoveComponent(EntityId aEntity)
+	{
+		RemoveComponent(T::comp_guid, aEntity);
+	}
+
+	template<typename T>
+	inline void CommandBuffer::SetComponent(EntityId aEntity, const T& aComponent)
+	{
+		static_assert(std::is_trivially_copyable_v<T>);
+
+		SetComponent(std::span<const uint8_t>(reinterpret_cast<const uint8_t*>(&aComponent), sizeof(T)), T::comp_guid, aEntity);
+	}
+}
\ No newline at end of file
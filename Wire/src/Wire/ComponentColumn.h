@@ -0,0 +1,78 @@
+#pragma once
+
+#include "Entity.h"
+#include "ComponentPool.hpp"
+
+#include <span>
+#include <utility>
+
+namespace Wire
+{
+	/*
+	* Typed access to one column of a pool with a column layout. The values are stored per page,
+	* so the column is walked in chunks of contiguous values, one chunk per pool page in dense order.
+	* Mutable chunks mark the components of their page as changed.
+	*/
+	template<typename P>
+	class ComponentColumn
+	{
+	public:
+		ComponentColumn() = default;
+		ComponentColumn(ComponentPool* aPool, size_t aColumn);
+
+		inline const size_t GetSize() const { return m_pool ? m_pool->GetComponentView().size() : 0; }
+		inline const size_t GetChunkCount() const { return m_pool ? m_pool->GetPageCount() : 0; }
+
+		std::span<const P> GetChunk(size_t aChunk) const;
+		std::span<P> GetChunk(size_t aChunk);
+
+		// Calls func(std::span<P>) for every chunk
+		template<typename F>
+		void ForEachChunk(F&& func);
+
+		// The entity of every value in chunk order
+		std::span<const EntityId> GetEntities() const;
+
+	private:
+		ComponentPool* m_pool = nullptr;
+		size_t m_column = 0;
+	};
+
+	template<typename P>
+	inline ComponentColumn<P>::ComponentColumn(ComponentPool* aPool, size_t aColumn)
+		: m_pool(aPool), m_column(aColumn)
+	{
+		assert(m_pool && m_pool->HasColumnLayout());
+		assert(m_column < m_pool->GetColumns().size() && m_pool->GetColumns()[m_column].size == sizeof(P));
+	}
+
+	template<typename P>
+	inline std::span<const P> ComponentColumn<P>::GetChunk(size_t aChunk) const
+	{
+		const std::span<const uint8_t> data = std::as_const(*m_pool).GetColumnData(m_column, aChunk);
+		return std::span<const P>(reinterpret_cast<const P*>(data.data()), data.size() / sizeof(P));
+	}
+
+	template<typename P>
+	inline std::span<P> ComponentColumn<P>::GetChunk(size_t aChunk)
+	{
+		const std::span<uint8_t> data = m_pool->GetColumnData(m_column, aChunk);
+		return std::span<P>(reinterpret_cast<P*>(data.data()), data.size() / sizeof(P));
+	}
+
+	template<typename P>
+	template<typename F>
+	inline void ComponentColumn<P>::ForEachChunk(F&& func)
+	{
+		for (size_t chunk = 0; chunk < GetChunkCount(); chunk++)
+		{
+			func(GetChunk(chunk));
+		}
+	}
+
+	template<typename P>
+	inline std::span<const EntityId> ComponentColumn<P>::GetEntities() const
+	{
+		return m_pool->GetComponentView();
+	}
+}
\ No newline at end of file
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace Wire
+{
+	/*
+	* Type erased lifecycle functions of a component type, used by pools holding components that cannot be copied as bytes.
+	* Trivially copyable types have no ops, their pools keep copying and moving the bytes with memcpy.
+	*/
+	struct ComponentOps
+	{
+		void (*copyConstruct)(void* aDestination, const void* aSource) = nullptr;
+		void (*copyAssign)(void* aDestination, const void* aSource) = nullptr;
+		void (*moveConstruct)(void* aDestination, void* aSource) = nullptr;
+		void (*swap)(void* aFirst, void* aSecond) = nullptr;
+		void (*destroy)(void* aComponent) = nullptr;
+
+		// Returns nullptr for trivially copyable types
+		template<typename T>
+		static const ComponentOps* Get();
+	};
+
+	template<typename T>
+	inline const ComponentOps* ComponentOps::Get()
+	{
+		if constexpr (std::is_trivially_copyable_v<T>)
+		{
+			return nullptr;
+		}
+		else
+		{
+			static_assert(std::is_copy_constructible_v<T> && std::is_copy_assignable_v<T>, "Pools copy components when registries are copied or cloned");
+
+			static constexpr ComponentOps ops
+			{
+				[](void* aDestination, const void* aSource) { new (aDestination) T(*static_cast<const T*>(aSource)); },
+				[](void* aDestination, const void* aSource) { *static_cast<T*>(aDestination) = *static_cast<const T*>(aSource); },
+				[](void* aDestination, void* aSource) { new (aDestination) T(std::move(*static_cast<T*>(aSource))); },
+				[](void* aFirst, void* aSecond) { std::swap(*static_cast<T*>(aFirst), *static_cast<T*>(aSecond)); },
+				[](void* aComponent) { static_cast<T*>(aComponent)->~T(); }
+			};
+
+			return &ops;
+		}
+	}
+}
\ No newline at end of file
@@ -1,36 +1,695 @@
 #include "ComponentPool.hpp"
+#include "OwningGroup.h"
+#include "Query.h"
+
+#include <algorithm>
+#include <cstring>
 
 namespace Wire
 {
 	ComponentPool::ComponentPool(const ComponentPool& pool)
+		: ComponentPool(pool, pool.GetMemoryResource())
+	{
+	}
+
+	ComponentPool::ComponentPool(const ComponentPool& pool, std::pmr::memory_resource* aResource)
+		: m_pages(aResource), m_columns(aResource), m_columnPageOffsets(aResource), m_sparse(aResource), m_queries(aResource)
+	{
+		*this = pool;
+	}
+
+	ComponentPool::ComponentPool(uint32_t aSize, const ComponentOps* aOps, uint32_t aAlignment, std::pmr::memory_resource* aResource)
+		: m_componentSize(aSize), m_alignment(std::max(aAlignment, PageAlignment)), m_ops(aOps), m_pages(aResource), m_columns(aResource), m_columnPageOffsets(aResource), m_sparse(aResource), m_queries(aResource)
+	{
+		assert((m_alignment & (m_alignment - 1)) == 0);
+	}
+
+	ComponentPool& ComponentPool::operator=(const ComponentPool& pool)
 	{
+		if (this == &pool)
+		{
+			return *this;
+		}
+
 		m_componentSize = pool.m_componentSize;
-		m_pool = pool.m_pool;
-		m_entitiesWithComponent = pool.m_entitiesWithComponent;
-		m_toEntityMap = pool.m_toEntityMap;
+		m_alignment = pool.m_alignment;
+		m_columns = pool.m_columns;
+		m_columnPageOffsets = pool.m_columnPageOffsets;
+		m_ops = pool.m_ops;
+		m_group = nullptr;
+		m_queries.clear();
+		m_trackChanges = pool.m_trackChanges;
+		m_currentTick = pool.m_currentTick;
+		m_entitiesWithComponent = pool.m_entitiesWithComponent ? MakeShared<EntityList>(*pool.m_entitiesWithComponent) : nullptr;
+
+		m_pages.clear();
+		for (const auto& page : pool.m_pages)
+		{
+			m_pages.emplace_back(MakeShared<Page>(*page));
+		}
+
+		m_sparse.clear();
+		for (const auto& sparsePage : pool.m_sparse)
+		{
+			m_sparse.emplace_back(sparsePage ? MakeShared<SparsePage>(*sparsePage) : nullptr);
+		}
+
+		return *this;
 	}
 
-	ComponentPool::ComponentPool(uint32_t aSize)
-		: m_componentSize(aSize)
+	ComponentPool ComponentPool::Clone() const
 	{
-		m_pool.reserve(aSize * 100);
+		ComponentPool pool(0, nullptr, 0, GetMemoryResource());
+		pool.m_componentSize = m_componentSize;
+		pool.m_alignment = m_alignment;
+		pool.m_columns = m_columns;
+		pool.m_columnPageOffsets = m_columnPageOffsets;
+		pool.m_ops = m_ops;
+		pool.m_trackChanges = m_trackChanges;
+		pool.m_currentTick = m_currentTick;
+		pool.m_entitiesWithComponent = m_entitiesWithComponent;
+		pool.m_pages = m_pages;
+		pool.m_sparse = m_sparse;
+
+		return pool;
 	}
 
-	void ComponentPool::AddComponent(EntityId aId, const std::vector<uint8_t> data)
+	void ComponentPool::MakeUnique()
 	{
-		assert(!HasComponent(aId));
-		
-		size_t index = m_pool.size();
-		m_pool.resize(m_pool.size() + data.size());
-		memcpy_s(&m_pool[index], data.size(), data.data(), data.size());
-		
-		m_toEntityMap[aId] = index;
-		m_entitiesWithComponent.emplace_back(aId);
+		GetWritableEntities();
+
+		for (size_t i = 0; i < m_pages.size(); i++)
+		{
+			GetWritablePage(i);
+		}
+	}
+
+	void ComponentPool::AddComponent(EntityId aId, std::span<const uint8_t> data)
+	{
+		CheckComponentSize(data.size());
+
+		const uint32_t denseIndex = AppendEntity(aId);
+		ConstructAt(denseIndex, data.data());
+
+		if (IsObserved())
+		{
+			NotifyAdded(aId);
+		}
 	}	
 
-	void ComponentPool::SetComponentData(const std::vector<uint8_t>& data, EntityId aId)
+	void ComponentPool::AddComponents(std::span<const EntityId> aIds, std::span<const uint8_t> data)
+	{
+		if (data.size() != aIds.size() * m_componentSize)
+		{
+			throw std::logic_error("Component data does not match the size of the pool's components");
+		}
+
+		if (aIds.empty())
+		{
+			return;
+		}
+
+		const size_t firstDenseIndex = AppendEntities(aIds);
+
+		// Copy the data page by page
+		size_t copied = HasColumnLayout() ? aIds.size() : 0;
+		for (size_t i = 0; i < copied; i++)
+		{
+			ScatterComponent(firstDenseIndex + i, &data[i * m_componentSize]);
+		}
+
+		while (copied < aIds.size())
+		{
+			const size_t denseIndex = firstDenseIndex + copied;
+			const size_t count = std::min(aIds.size() - copied, ComponentsPerPage - denseIndex % ComponentsPerPage);
+			const size_t size = count * m_componentSize;
+			uint8_t* destination = GetWritableComponentPtr(denseIndex);
+
+			if (m_ops)
+			{
+				for (size_t i = 0; i < count; i++)
+				{
+					m_ops->copyConstruct(destination + i * m_componentSize, &data[(copied + i) * m_componentSize]);
+				}
+			}
+			else
+			{
+				memcpy(destination, &data[copied * m_componentSize], size);
+			}
+
+			copied += count;
+		}
+
+		if (IsObserved())
+		{
+			for (const EntityId id : aIds)
+			{
+				NotifyAdded(id);
+			}
+		}
+	}
+
+	void ComponentPool::AddComponentCopies(std::span<const EntityId> aIds, std::span<const uint8_t> aPrototype)
+	{
+		assert(aPrototype.size() == m_componentSize);
+
+		if (aIds.empty())
+		{
+			return;
+		}
+
+		const size_t firstDenseIndex = AppendEntities(aIds);
+
+		// Fill the first slot of each page, then double the filled range within the page
+		size_t copied = HasColumnLayout() ? aIds.size() : 0;
+		for (size_t i = 0; i < copied; i++)
+		{
+			ScatterComponent(firstDenseIndex + i, aPrototype.data());
+		}
+
+		while (copied < aIds.size())
+		{
+			const size_t denseIndex = firstDenseIndex + copied;
+			const size_t count = std::min(aIds.size() - copied, ComponentsPerPage - denseIndex % ComponentsPerPage);
+			uint8_t* destination = GetWritableComponentPtr(denseIndex);
+
+			if (m_ops)
+			{
+				for (size_t i = 0; i < count; i++)
+				{
+					m_ops->copyConstruct(destination + i * m_componentSize, aPrototype.data());
+				}
+
+				copied += count;
+				continue;
+			}
+
+			memcpy(destination, aPrototype.data(), m_componentSize);
+			for (size_t filled = 1; filled < count;)
+			{
+				const size_t chunk = std::min(filled, count - filled);
+				memcpy(destination + filled * m_componentSize, destination, chunk * m_componentSize);
+				filled += chunk;
+			}
+
+			copied += count;
+		}
+
+		if (IsObserved())
+		{
+			for (const EntityId id : aIds)
+			{
+				NotifyAdded(id);
+			}
+		}
+	}
+
+	void ComponentPool::RemoveComponents(std::span<const EntityId> aIds)
+	{
+		// Removing every component only has to reset the sparse entries, grouped pools keep their group updated one by one
+		if (!m_group && aIds.size() >= GetComponentView().size())
+		{
+			size_t matching = 0;
+			for (const EntityId id : aIds)
+			{
+				matching += HasComponent(id) ? 1 : 0;
+			}
+
+			if (matching == GetComponentView().size())
+			{
+				for (const EntityId id : aIds)
+				{
+					GetSparseEntry(id) = NullIndex;
+				}
+
+				WIRE_STATS(m_counters.removes.Add(matching));
+				GetWritableEntities().clear();
+				m_pages.clear();
+
+				// Every query over the pool needs this component
+				for (QueryCache* query : m_queries)
+				{
+					query->Clear();
+				}
+
+				return;
+			}
+		}
+
+		for (const EntityId id : aIds)
+		{
+			if (HasComponent(id))
+			{
+				RemoveComponent(id);
+			}
+		}
+	}
+
+	void ComponentPool::SwapDense(uint32_t aFirst, uint32_t aSecond)
+	{
+		if (aFirst == aSecond)
+		{
+			return;
+		}
+
+		EntityList& entities = GetWritableEntities();
+		std::swap(entities[aFirst], entities[aSecond]);
+		GetSparseEntry(entities[aFirst]) = aFirst;
+		GetSparseEntry(entities[aSecond]) = aSecond;
+
+		uint8_t* first = GetWritableComponentPtr(aFirst);
+		uint8_t* second = GetWritableComponentPtr(aSecond);
+
+		if (HasColumnLayout())
+		{
+			SwapColumns(aFirst, aSecond);
+		}
+		else if (m_ops)
+		{
+			m_ops->swap(first, second);
+		}
+		else
+		{
+			std::swap_ranges(first, first + m_componentSize, second);
+		}
+
+		if (m_trackChanges)
+		{
+			std::swap(GetWritablePage(aFirst / ComponentsPerPage).versions[aFirst % ComponentsPerPage], GetWritablePage(aSecond / ComponentsPerPage).versions[aSecond % ComponentsPerPage]);
+		}
+	}
+
+	void ComponentPool::SetComponentData(std::span<const uint8_t> data, EntityId aId)
+	{
+		assert(HasComponent(aId));
+		CheckComponentSize(data.size());
+		const uint32_t denseIndex = GetDenseIndex(aId);
+
+		StampVersion(denseIndex);
+		uint8_t* component = GetWritableComponentPtr(denseIndex);
+
+		if (HasColumnLayout())
+		{
+			ScatterComponent(denseIndex, data.data());
+		}
+		else if (m_ops)
+		{
+			m_ops->copyAssign(component, data.data());
+		}
+		else
+		{
+			memcpy(component, data.data(), m_componentSize);
+		}
+	}
+
+	void ComponentPool::EnableChangeTracking()
+	{
+		if (m_trackChanges)
+		{
+			return;
+		}
+
+		m_trackChanges = true;
+		for (size_t i = 0; i < m_pages.size(); i++)
+		{
+			GetWritablePage(i).versions.assign(ComponentsPerPage, m_currentTick);
+		}
+	}
+
+	void ComponentPool::CopyComponentData(EntityId aId, std::span<uint8_t> outData) const
+	{
+		assert(HasComponent(aId));
+		assert(outData.size() >= m_componentSize);
+		WIRE_STATS(m_counters.gets.Add());
+
+		const uint32_t denseIndex = GetDenseIndex(aId);
+		if (HasColumnLayout())
+		{
+			GatherComponent(denseIndex, outData.data());
+		}
+		else
+		{
+			memcpy(outData.data(), GetComponentPtr(denseIndex), m_componentSize);
+		}
+	}
+
+	void ComponentPool::SetColumnLayout(std::span<const Column> aColumns)
+	{
+		assert(!m_ops && "Column layouts need trivially copyable components");
+
+		// Read every page in the current layout before switching
+		std::vector<uint8_t> components(GetComponentView().size() * m_componentSize);
+		for (size_t i = 0; i < GetComponentView().size(); i++)
+		{
+			CopyComponentData(GetComponentView()[i], std::span<uint8_t>(&components[i * m_componentSize], m_componentSize));
+		}
+
+		m_columns.assign(aColumns.begin(), aColumns.end());
+		m_columnPageOffsets.clear();
+
+		size_t pageOffset = 0;
+		for (const Column& column : m_columns)
+		{
+			assert(column.componentOffset + column.size <= m_componentSize);
+
+			m_columnPageOffsets.emplace_back(pageOffset);
+			pageOffset += (size_t)column.size * ComponentsPerPage;
+		}
+
+		for (size_t i = 0; i < m_pages.size(); i++)
+		{
+			GetWritablePage(i).columnLayout = HasColumnLayout();
+		}
+
+		for (size_t i = 0; i < GetComponentView().size(); i++)
+		{
+			ScatterComponent(i, &components[i * m_componentSize]);
+		}
+	}
+
+	std::span<const uint8_t> ComponentPool::GetColumnData(size_t aColumn, size_t aPageIndex) const
+	{
+		const size_t count = std::min(GetComponentView().size() - aPageIndex * ComponentsPerPage, (size_t)ComponentsPerPage);
+		return std::span<const uint8_t>(m_pages[aPageIndex]->data + m_columnPageOffsets[aColumn], count * m_columns[aColumn].size);
+	}
+
+	std::span<uint8_t> ComponentPool::GetColumnData(size_t aColumn, size_t aPageIndex)
+	{
+		const size_t firstDenseIndex = aPageIndex * ComponentsPerPage;
+		const size_t count = std::min(GetComponentView().size() - firstDenseIndex, (size_t)ComponentsPerPage);
+
+		for (size_t i = 0; i < count && m_trackChanges; i++)
+		{
+			StampVersion(firstDenseIndex + i);
+		}
+
+		return std::span<uint8_t>(GetWritablePage(aPageIndex).data + m_columnPageOffsets[aColumn], count * m_columns[aColumn].size);
+	}
+
+	std::span<const uint8_t> ComponentPool::GetPropertyBytes(EntityId aId, uint32_t aOffset, uint32_t aSize) const
 	{
 		assert(HasComponent(aId));
-		memcpy_s(&m_pool[m_toEntityMap.at(aId)], m_componentSize, data.data(), data.size());
+		assert(aOffset + aSize <= m_componentSize);
+		WIRE_STATS(m_counters.gets.Add());
+
+		const uint32_t denseIndex = GetDenseIndex(aId);
+		if (!HasColumnLayout())
+		{
+			return std::span<const uint8_t>(GetComponentPtr(denseIndex) + aOffset, aSize);
+		}
+
+		const uint8_t* pageData = m_pages[denseIndex / ComponentsPerPage]->data;
+		return std::span<const uint8_t>(pageData + m_columnPageOffsets[FindColumn(aOffset, aSize)] + (size_t)(denseIndex % ComponentsPerPage) * aSize, aSize);
+	}
+
+	std::span<uint8_t> ComponentPool::GetPropertyBytes(EntityId aId, uint32_t aOffset, uint32_t aSize)
+	{
+		assert(HasComponent(aId));
+		assert(aOffset + aSize <= m_componentSize);
+		WIRE_STATS(m_counters.gets.Add());
+
+		const uint32_t denseIndex = GetDenseIndex(aId);
+		StampVersion(denseIndex);
+
+		if (!HasColumnLayout())
+		{
+			return std::span<uint8_t>(GetWritableComponentPtr(denseIndex) + aOffset, aSize);
+		}
+
+		uint8_t* pageData = GetWritablePage(denseIndex / ComponentsPerPage).data;
+		return std::span<uint8_t>(pageData + m_columnPageOffsets[FindColumn(aOffset, aSize)] + (size_t)(denseIndex % ComponentsPerPage) * aSize, aSize);
+	}
+
+	std::span<const uint8_t> ComponentPool::GetPageData(size_t aPageIndex) const
+	{
+		CheckComponentLayout();
+
+		const size_t firstDenseIndex = aPageIndex * ComponentsPerPage;
+		const size_t count = std::min(GetComponentView().size() - firstDenseIndex, (size_t)ComponentsPerPage);
+
+		return std::span<const uint8_t>(m_pages[aPageIndex]->data, count * m_componentSize);
+	}
+
+	uint32_t ComponentPool::AppendEntity(EntityId aId)
+	{
+		uint32_t& sparseEntry = GetSparseEntry(aId);
+		assert(sparseEntry == NullIndex);
+
+		EntityList& entities = GetWritableEntities();
+		const uint32_t denseIndex = (uint32_t)entities.size();
+
+		sparseEntry = denseIndex;
+		WIRE_STATS(m_counters.adds.Add());
+		WIRE_STATS(m_counters.denseReallocations.Add(entities.size() == entities.capacity() ? 1 : 0));
+		entities.emplace_back(aId);
+
+		if (denseIndex / ComponentsPerPage >= m_pages.size())
+		{
+			m_pages.emplace_back(CreatePage());
+		}
+
+		GetWritablePage(denseIndex / ComponentsPerPage).count++;
+		StampVersion(denseIndex);
+		return denseIndex;
+	}
+
+	size_t ComponentPool::AppendEntities(std::span<const EntityId> aIds)
+	{
+		EntityList& entities = GetWritableEntities();
+		const size_t firstDenseIndex = entities.size();
+		WIRE_STATS(m_counters.adds.Add(aIds.size()));
+		WIRE_STATS(m_counters.denseReallocations.Add(firstDenseIndex + aIds.size() > entities.capacity() ? 1 : 0));
+		entities.reserve(firstDenseIndex + aIds.size());
+
+		for (const EntityId id : aIds)
+		{
+			uint32_t& sparseEntry = GetSparseEntry(id);
+			assert(sparseEntry == NullIndex);
+
+			sparseEntry = (uint32_t)entities.size();
+			entities.emplace_back(id);
+		}
+
+		const size_t pageCount = (entities.size() + ComponentsPerPage - 1) / ComponentsPerPage;
+		m_pages.reserve(pageCount);
+
+		while (m_pages.size() < pageCount)
+		{
+			m_pages.emplace_back(CreatePage());
+		}
+
+		for (size_t page = firstDenseIndex / ComponentsPerPage; page < pageCount; page++)
+		{
+			GetWritablePage(page).count = (uint32_t)std::min(entities.size() - page * ComponentsPerPage, (size_t)ComponentsPerPage);
+		}
+
+		if (m_trackChanges)
+		{
+			for (size_t i = firstDenseIndex; i < entities.size(); i++)
+			{
+				StampVersion(i);
+			}
+		}
+
+		return firstDenseIndex;
+	}
+
+	void ComponentPool::NotifyAdded(EntityId aId)
+	{
+		if (m_group)
+		{
+			m_group->OnComponentAdded(aId);
+		}
+
+		for (QueryCache* query : m_queries)
+		{
+			query->OnComponentAdded(aId);
+		}
+	}
+
+	void ComponentPool::NotifyRemoving(EntityId aId)
+	{
+		if (m_group)
+		{
+			m_group->OnComponentRemoving(aId);
+		}
+
+		for (QueryCache* query : m_queries)
+		{
+			query->OnComponentRemoving(aId);
+		}
+	}
+
+	void ComponentPool::ConstructAt(size_t aDenseIndex, const uint8_t* aSource)
+	{
+		if (HasColumnLayout())
+		{
+			ScatterComponent(aDenseIndex, aSource);
+		}
+		else if (m_ops)
+		{
+			m_ops->copyConstruct(GetWritableComponentPtr(aDenseIndex), aSource);
+		}
+		else
+		{
+			memcpy(GetWritableComponentPtr(aDenseIndex), aSource, m_componentSize);
+		}
+	}
+
+	void ComponentPool::ScatterComponent(size_t aDenseIndex, const uint8_t* aSource)
+	{
+		uint8_t* page = GetWritablePage(aDenseIndex / ComponentsPerPage).data;
+		const size_t slot = aDenseIndex % ComponentsPerPage;
+
+		for (size_t i = 0; i < m_columns.size(); i++)
+		{
+			const Column& column = m_columns[i];
+			memcpy(page + m_columnPageOffsets[i] + slot * column.size, aSource + column.componentOffset, column.size);
+		}
+	}
+
+	void ComponentPool::GatherComponent(size_t aDenseIndex, uint8_t* aDestination) const
+	{
+		const uint8_t* page = m_pages[aDenseIndex / ComponentsPerPage]->data;
+		const size_t slot = aDenseIndex % ComponentsPerPage;
+
+		// Bytes not covered by a column, such as padding, read as zero
+		memset(aDestination, 0, m_componentSize);
+
+		for (size_t i = 0; i < m_columns.size(); i++)
+		{
+			const Column& column = m_columns[i];
+			memcpy(aDestination + column.componentOffset, page + m_columnPageOffsets[i] + slot * column.size, column.size);
+		}
+	}
+
+	void ComponentPool::MoveColumns(size_t aSourceIndex, size_t aDestinationIndex)
+	{
+		const uint8_t* source = GetWritablePage(aSourceIndex / ComponentsPerPage).data;
+		uint8_t* destination = GetWritablePage(aDestinationIndex / ComponentsPerPage).data;
+
+		for (size_t i = 0; i < m_columns.size(); i++)
+		{
+			const size_t size = m_columns[i].size;
+			memcpy(destination + m_columnPageOffsets[i] + (aDestinationIndex % ComponentsPerPage) * size, source + m_columnPageOffsets[i] + (aSourceIndex % ComponentsPerPage) * size, size);
+		}
+	}
+
+	void ComponentPool::SwapColumns(size_t aFirst, size_t aSecond)
+	{
+		uint8_t* first = GetWritablePage(aFirst / ComponentsPerPage).data;
+		uint8_t* second = GetWritablePage(aSecond / ComponentsPerPage).data;
+
+		for (size_t i = 0; i < m_columns.size(); i++)
+		{
+			const size_t size = m_columns[i].size;
+			uint8_t* firstValue = first + m_columnPageOffsets[i] + (aFirst % ComponentsPerPage) * size;
+
+			std::swap_ranges(firstValue, firstValue + size, second + m_columnPageOffsets[i] + (aSecond % ComponentsPerPage) * size);
+		}
+	}
+
+	size_t ComponentPool::FindColumn(uint32_t aOffset, uint32_t aSize) const
+	{
+		for (size_t column = 0; column < m_columns.size(); column++)
+		{
+			if (m_columns[column].componentOffset == aOffset && m_columns[column].size == aSize)
+			{
+				return column;
+			}
+		}
+
+		assert(false && "The range is not a column of the pool");
+		return 0;
+	}
+
+	PoolStats ComponentPool::GetStats() const
+	{
+		PoolStats stats;
+		stats.componentSize = m_componentSize;
+		stats.componentCount = GetComponentView().size();
+		stats.pageCount = m_pages.size();
+
+		for (const auto& page : m_pages)
+		{
+			stats.sharedPageCount += page.use_count() > 1 ? 1 : 0;
+			stats.bytesReserved += (size_t)ComponentsPerPage * m_componentSize + page->versions.capacity() * sizeof(uint64_t);
+		}
+
+		stats.bytesReserved += m_sparse.capacity() * sizeof(std::shared_ptr<SparsePage>) + (m_entitiesWithComponent ? m_entitiesWithComponent->capacity() * sizeof(EntityId) : 0);
+		for (const auto& sparsePage : m_sparse)
+		{
+			stats.bytesReserved += sparsePage ? SparsePageSize * sizeof(uint32_t) : 0;
+		}
+
+		// Every component needs its data, its dense entry, its sparse entry and its version when tracking changes
+		const size_t bytesPerComponent = m_componentSize + sizeof(EntityId) + sizeof(uint32_t) + (m_trackChanges ? sizeof(uint64_t) : 0);
+		stats.bytesUsed = stats.componentCount * bytesPerComponent;
+
+#ifdef WIRE_ENABLE_STATS
+		stats.addCount = m_counters.adds.Get();
+		stats.removeCount = m_counters.removes.Get();
+		stats.getCount = m_counters.gets.Get();
+		stats.pageAllocations = m_counters.pageAllocations.Get();
+		stats.pageCopies = m_counters.pageCopies.Get();
+		stats.sparsePageAllocations = m_counters.sparsePageAllocations.Get();
+		stats.denseReallocations = m_counters.denseReallocations.Get();
+#endif
+
+		return stats;
+	}
+
+	std::shared_ptr<ComponentPool::Page> ComponentPool::CreatePage() const
+	{
+		auto page = MakeShared<Page>(m_componentSize, m_alignment, m_ops);
+		page->columnLayout = HasColumnLayout();
+		WIRE_STATS(m_counters.pageAllocations.Add());
+
+		if (m_trackChanges)
+		{
+			page->versions.resize(ComponentsPerPage, m_currentTick);
+		}
+
+		return page;
+	}
+
+	ComponentPool::Page::Page(uint32_t aComponentSize, uint32_t aAlignment, const ComponentOps* aOps, const allocator_type& aAllocator)
+		: versions(aAllocator), componentSize(aComponentSize), alignment(aAlignment), ops(aOps), resource(aAllocator.resource())
+	{
+		data = static_cast<uint8_t*>(resource->allocate((size_t)ComponentsPerPage * componentSize, alignment));
+	}
+
+	ComponentPool::Page::Page(const Page& page, const allocator_type& aAllocator)
+		: Page(page.componentSize, page.alignment, page.ops, aAllocator)
+	{
+		versions = page.versions;
+		count = page.count;
+		columnLayout = page.columnLayout;
+
+		// Only the constructed components are copied, columns are spread over the whole page
+		if (!ops)
+		{
+			const size_t size = (columnLayout ? ComponentsPerPage : count) * (size_t)componentSize;
+			memcpy(data, page.data, size);
+			return;
+		}
+
+		for (uint32_t i = 0; i < count; i++)
+		{
+			ops->copyConstruct(data + (size_t)i * componentSize, page.data + (size_t)i * componentSize);
+		}
+	}
+
+	ComponentPool::Page::~Page()
+	{
+		if (ops)
+		{
+			for (uint32_t i = 0; i < count; i++)
+			{
+				ops->destroy(data + (size_t)i * componentSize);
+			}
+		}
+
+		resource->deallocate(data, (size_t)ComponentsPerPage * componentSize, alignment);
 	}
 }
\ No newline at end of file
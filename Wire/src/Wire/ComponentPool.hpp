@@ -1,91 +1,418 @@
 #pragma once
 
 #include "Entity.h"
+#include "ComponentOps.h"
+#include "Stats.h"
 
 #include <vector>
-#include <unordered_map>
+#include <span>
+#include <memory>
+#include <memory_resource>
+#include <limits>
+#include <stdexcept>
 #include <cassert>
+#include <type_traits>
+#include <cstring>
 
 namespace Wire
 {
+	class OwningGroup;
+	class QueryCache;
+
+	/*
+	* Component data is stored in fixed size pages, the sparse set is paged as well.
+	* Pages are allocated aligned to at least a cache line and never reallocated, so growing the pool does not move
+	* existing components. Removing a component moves the last one into its slot.
+	* Pages are shared between clones and copied the first time a pool writes to a shared page.
+	* Components of types with ComponentOps are constructed, moved and destroyed through them, others are copied as bytes.
+	* All pages, the sparse set and the dense array are allocated from the pool's memory resource.
+	*/
 	class ComponentPool
 	{
 	public:
 		ComponentPool() = default;
 		ComponentPool(const ComponentPool& pool);
-		ComponentPool(uint32_t aSize);
 
-		void AddComponent(EntityId aId, const std::vector<uint8_t> data);
+		// Copies the pool into aResource, the copy constructor keeps the memory resource of pool
+		ComponentPool(const ComponentPool& pool, std::pmr::memory_resource* aResource);
 
-		template<typename T>
-		T& AddComponent(EntityId aId, T& aComponent);
+		ComponentPool(ComponentPool&& pool) = default;
+		ComponentPool(uint32_t aSize, const ComponentOps* aOps = nullptr, uint32_t aAlignment = 0, std::pmr::memory_resource* aResource = std::pmr::get_default_resource());
+
+		ComponentPool& operator=(const ComponentPool& pool);
+		ComponentPool& operator=(ComponentPool&& pool) = default;
+
+		// Returns a pool sharing all pages with this one, the copy constructor copies the pages instead
+		ComponentPool Clone() const;
+
+		// Copies every page still shared with a clone, needed before writing to the pool from several threads
+		void MakeUnique();
+
+		// Copy constructs the component from data, throws std::logic_error if data is not exactly one component
+		void AddComponent(EntityId aId, std::span<const uint8_t> data);
+
+		// Appends aIds.size() components, data holds them tightly packed in the same order, throws std::logic_error for any other size
+		void AddComponents(std::span<const EntityId> aIds, std::span<const uint8_t> data);
+
+		// Appends aIds.size() copies of aPrototype
+		void AddComponentCopies(std::span<const EntityId> aIds, std::span<const uint8_t> aPrototype);
+
+		// Constructs the component in place. Throws std::logic_error with a column layout, add those through the byte overloads
+		template<typename T, typename ... Args>
+		T& EmplaceComponent(EntityId aId, Args&&... args);
 
 		void RemoveComponent(EntityId aId);
 
+		// Entities without the component are skipped, the ids must be unique
+		void RemoveComponents(std::span<const EntityId> aIds);
+
+		// Mutable access marks the component as changed, use a const T to read without marking it. Throws std::logic_error with a column layout
 		template<typename T>
 		T& GetComponent(EntityId aId);
 
-		// Copies the data
+		// Access by dense index, for iterating code that already looked the entity up and called CheckComponentLayout
+		template<typename T>
+		T& GetComponentAt(uint32_t aDenseIndex);
+
+		// Returns NullIndex if the entity has no component
+		uint32_t GetDenseIndex(EntityId aId) const;
+
+		// Copies the data, works for both layouts. SetComponentData throws std::logic_error if data is not exactly one component
 		std::vector<uint8_t> GetComponentData(EntityId aId) const;
-		void SetComponentData(const std::vector<uint8_t>& data, EntityId aId);
+		void CopyComponentData(EntityId aId, std::span<uint8_t> outData) const;
+		void SetComponentData(std::span<const uint8_t> data, EntityId aId);
+
+		// Views the component's bytes in place, valid until the pool is modified. Throws std::logic_error with a column layout
+		std::span<const uint8_t> GetComponentBytes(EntityId aId) const;
+		std::span<uint8_t> GetComponentBytes(EntityId aId);
+
+		// Views a byte range of the component in place, works for both layouts. With a column layout the range must be a column
+		std::span<const uint8_t> GetPropertyBytes(EntityId aId, uint32_t aOffset, uint32_t aSize) const;
+		std::span<uint8_t> GetPropertyBytes(EntityId aId, uint32_t aOffset, uint32_t aSize);
 
 		bool HasComponent(EntityId aId) const;
 
-		inline const std::vector<uint8_t>& GetAllComponents() const { return m_pool; }
+		/*
+		* Change tracking: every component stores the tick it was last added or mutably accessed at.
+		* The versions are dense, so finding changed components is a linear scan.
+		*/
+		void EnableChangeTracking();
+		void MarkChanged(EntityId aId);
+
+		// Calls func(id, component) for every component changed at or after aSinceTick, without marking them again
+		template<typename T, typename F>
+		void ForEachChanged(uint64_t aSinceTick, F&& func);
+
+		inline void SetCurrentTick(uint64_t aTick) { m_currentTick = aTick; }
+		inline const bool IsTrackingChanges() const { return m_trackChanges; }
+		uint64_t GetVersion(size_t aDenseIndex) const;
+
+		// The components of a page, tightly packed in dense order. Not available with a column layout
+		std::span<const uint8_t> GetPageData(size_t aPageIndex) const;
+		inline const size_t GetPageCount() const { return m_pages.size(); }
+
+		/*
+		* Diffing against a clone: a page still shared with aClone was not written by either pool since cloning,
+		* so it holds the same entities and component data at the same dense indices.
+		*/
+		inline const bool SharesPage(const ComponentPool& aClone, size_t aPageIndex) const { return aPageIndex < m_pages.size() && aPageIndex < aClone.m_pages.size() && m_pages[aPageIndex] == aClone.m_pages[aPageIndex]; }
+
+		// Calls func(id) for every entity with a component in a sparse page not shared with aClone, these are the only ones that can have been added or removed
+		template<typename F>
+		void ForEachUnsharedEntity(const ComponentPool& aClone, F&& func) const;
+
+		/*
+		* Column layout: every page stores each column (a byte range of the component, usually a property) contiguously
+		* instead of storing whole components. Only for trivially copyable components, typed references to whole
+		* components and the in place byte views are not available, the data is accessed by column or copied.
+		*/
+		struct Column
+		{
+			uint32_t componentOffset = 0;
+			uint32_t size = 0;
+		};
+
+		// Converts the existing pages, the columns must not overlap
+		void SetColumnLayout(std::span<const Column> aColumns);
+		inline const bool HasColumnLayout() const { return !m_columns.empty(); }
+		inline const std::pmr::vector<Column>& GetColumns() const { return m_columns; }
+
+		// Typed references need whole components, throws std::logic_error if the pool has a column layout
+		void CheckComponentLayout() const;
+
+		// Raw bytes are not objects, throws std::logic_error if the components have to be built through ComponentOps
+		void CheckTriviallyCopyable() const;
+
+		// Byte spans from outside the pool may have any size, throws std::logic_error unless aSize is the component size
+		void CheckComponentSize(size_t aSize) const;
+
+		// The values of a column in a page, mutable access marks the components of the page as changed
+		std::span<const uint8_t> GetColumnData(size_t aColumn, size_t aPageIndex) const;
+		std::span<uint8_t> GetColumnData(size_t aColumn, size_t aPageIndex);
+
+		// Swaps two dense entries together with their data and versions
+		void SwapDense(uint32_t aFirst, uint32_t aSecond);
+
+		// The group keeping this pool sorted, copies of the pool are not part of any group
+		inline void SetGroup(OwningGroup* aGroup) { m_group = aGroup; }
+		inline OwningGroup* GetGroup() const { return m_group; }
+
+		// Cached queries over this pool are told about added and removed components, copies of the pool are not observed
+		inline void AddQuery(QueryCache* aQuery) { m_queries.emplace_back(aQuery); }
+
 		inline const uint32_t GetComponentSize() const { return m_componentSize; }
-		inline const std::vector<EntityId>& GetComponentView() const { return m_entitiesWithComponent; }
+		inline const ComponentOps* GetOps() const { return m_ops; }
+		inline const uint32_t GetAlignment() const { return m_alignment; }
+		inline std::span<const EntityId> GetComponentView() const { return m_entitiesWithComponent ? std::span<const EntityId>(*m_entitiesWithComponent) : std::span<const EntityId>(); }
+		inline std::pmr::memory_resource* GetMemoryResource() const { return m_pages.get_allocator().resource(); }
+
+		// Memory and occupancy, plus the operation counts when built with WIRE_ENABLE_STATS
+		PoolStats GetStats() const;
+
+		static constexpr uint32_t NullIndex = std::numeric_limits<uint32_t>::max();
+		static constexpr uint32_t ComponentsPerPage = 1024;
+
+		// Minimum alignment of every page
+		static constexpr uint32_t PageAlignment = 64;
 
 	private:
+		struct Page
+		{
+			// Allocator aware, so allocate_shared with a polymorphic allocator passes the memory resource on
+			using allocator_type = std::pmr::polymorphic_allocator<>;
+
+			Page(uint32_t aComponentSize, uint32_t aAlignment, const ComponentOps* aOps, const allocator_type& aAllocator);
+			Page(const Page& page, const allocator_type& aAllocator);
+			Page(const Page&) = delete;
+			~Page();
+
+			Page& operator=(const Page&) = delete;
+
+			uint8_t* data = nullptr; // Room for ComponentsPerPage components, aligned to alignment
+			bool columnLayout = false;
+			std::pmr::vector<uint64_t> versions; // Only filled when tracking changes
+
+			uint32_t count = 0; // The first count components are constructed
+			uint32_t componentSize = 0;
+			uint32_t alignment = 0;
+			const ComponentOps* ops = nullptr;
+			std::pmr::memory_resource* resource = nullptr;
+		};
+
+		using SparsePage = std::pmr::vector<uint32_t>;
+		using EntityList = std::pmr::vector<EntityId>;
+
+		static constexpr uint32_t SparsePageSize = 4096;
+
+		uint32_t& GetSparseEntry(EntityId aId);
+
+		// Adds aId at the end of the dense arrays and returns its dense index, the caller must construct the component right away
+		uint32_t AppendEntity(EntityId aId);
+
+		// Appends all ids with a single reserve and returns the dense index of the first one
+		size_t AppendEntities(std::span<const EntityId> aIds);
+
+		const uint8_t* GetComponentPtr(size_t aDenseIndex) const;
+		uint8_t* GetWritableComponentPtr(size_t aDenseIndex);
+
+		Page& GetWritablePage(size_t aPageIndex);
+		EntityList& GetWritableEntities();
+		std::shared_ptr<Page> CreatePage() const;
+
+		// Allocates the object and its control block from the memory resource, which is passed on to the object
+		template<typename T, typename ... Args>
+		std::shared_ptr<T> MakeShared(Args&&... args) const;
+
+		void StampVersion(size_t aDenseIndex);
+
+		// Updates the group and the queries, only needed while IsObserved
+		inline const bool IsObserved() const { return m_group || !m_queries.empty(); }
+		void NotifyAdded(EntityId aId);
+		void NotifyRemoving(EntityId aId);
+
+		// Copy constructs from aSource, or copies the bytes for types without ops
+		void ConstructAt(size_t aDenseIndex, const uint8_t* aSource);
+
+		// Column layout versions of the component accesses
+		void ScatterComponent(size_t aDenseIndex, const uint8_t* aSource);
+		void GatherComponent(size_t aDenseIndex, uint8_t* aDestination) const;
+		void MoveColumns(size_t aSourceIndex, size_t aDestinationIndex);
+		void SwapColumns(size_t aFirst, size_t aSecond);
+		size_t FindColumn(uint32_t aOffset, uint32_t aSize) const;
+
 		uint32_t m_componentSize = 0;
-		std::vector<uint8_t> m_pool;
-		std::vector<EntityId> m_entitiesWithComponent;
-		std::unordered_map<EntityId, size_t> m_toEntityMap;
+		uint32_t m_alignment = PageAlignment;
+		const ComponentOps* m_ops = nullptr;
+		std::pmr::vector<std::shared_ptr<Page>> m_pages;
+
+		std::pmr::vector<Column> m_columns;
+		std::pmr::vector<size_t> m_columnPageOffsets; // Byte offset of every column inside a page
+
+		bool m_trackChanges = false;
+		uint64_t m_currentTick = 0;
+
+		// Sparse set: m_sparse maps an entity to its dense index, pages are allocated on demand.
+		// m_entitiesWithComponent maps a dense index back to the entity and is copied as a whole when shared,
+		// it is allocated with the first component.
+		std::shared_ptr<EntityList> m_entitiesWithComponent;
+		std::pmr::vector<std::shared_ptr<SparsePage>> m_sparse;
+
+		OwningGroup* m_group = nullptr;
+		std::pmr::vector<QueryCache*> m_queries;
+
+		WIRE_STATS(mutable PoolCounters m_counters;)
 	};
 
-	template<typename T>
-	inline T& ComponentPool::AddComponent(EntityId aId, T& aComponent)
+	template<typename T, typename ... Args>
+	inline T& ComponentPool::EmplaceComponent(EntityId aId, Args&&... args)
 	{
-		auto it = m_toEntityMap.find(aId);
-		assert(it == m_toEntityMap.end());
+		assert(sizeof(T) == m_componentSize);
+		CheckComponentLayout();
 
-		size_t index = m_pool.size();
-		m_pool.resize(m_pool.size() + sizeof(T));
-		memcpy_s(&m_pool[index], sizeof(T), &aComponent, sizeof(T));
+		const uint32_t denseIndex = AppendEntity(aId);
+		T* component = new (GetWritableComponentPtr(denseIndex)) T(std::forward<Args>(args)...);
 
-		m_toEntityMap[aId] = index;
-		m_entitiesWithComponent.emplace_back(aId);
+		// The group may move the component to the front
+		if (IsObserved())
+		{
+			NotifyAdded(aId);
+			component = reinterpret_cast<T*>(GetWritableComponentPtr(GetDenseIndex(aId)));
+		}
 
-		return *reinterpret_cast<T*>(&m_pool[index]);
+		return *component;
 	}
 
 	inline void ComponentPool::RemoveComponent(EntityId aId)
 	{
-		auto it = m_toEntityMap.find(aId);
-		assert(it != m_toEntityMap.end());
+		assert(HasComponent(aId));
+		WIRE_STATS(m_counters.removes.Add());
+
+		if (IsObserved())
+		{
+			NotifyRemoving(aId);
+		}
 
-		const size_t lastComponentIndex = m_pool.size() - m_componentSize;
+		const uint32_t denseIndex = GetDenseIndex(aId);
+		EntityList& entities = GetWritableEntities();
+		const uint32_t lastDenseIndex = (uint32_t)entities.size() - 1;
 
-		memcpy_s(&m_pool[it->second], m_componentSize, &m_pool[lastComponentIndex], m_componentSize);
-		m_pool.resize(m_pool.size() - m_componentSize);
+		Page& lastPage = GetWritablePage(lastDenseIndex / ComponentsPerPage);
+		uint8_t* last = lastPage.data + (lastDenseIndex % ComponentsPerPage) * m_componentSize;
 
-		for (auto& newIt : m_toEntityMap)
+		if (denseIndex != lastDenseIndex)
 		{
-			if (newIt.second == lastComponentIndex)
+			const EntityId lastEntity = entities[lastDenseIndex];
+			uint8_t* removed = GetWritableComponentPtr(denseIndex);
+
+			if (HasColumnLayout())
+			{
+				MoveColumns(lastDenseIndex, denseIndex);
+			}
+			else if (m_ops)
+			{
+				m_ops->destroy(removed);
+				m_ops->moveConstruct(removed, last);
+			}
+			else
+			{
+				memcpy(removed, last, m_componentSize);
+			}
+
+			entities[denseIndex] = lastEntity;
+			GetSparseEntry(lastEntity) = denseIndex;
+
+			if (m_trackChanges)
 			{
-				newIt.second = it->second;
-				break;
+				GetWritablePage(denseIndex / ComponentsPerPage).versions[denseIndex % ComponentsPerPage] = GetVersion(lastDenseIndex);
 			}
 		}
 
-		m_entitiesWithComponent.erase(std::find(m_entitiesWithComponent.begin(), m_entitiesWithComponent.end(), aId));
-		m_toEntityMap.erase(it);
+		// The last slot is now either moved from or the removed component
+		if (m_ops)
+		{
+			m_ops->destroy(last);
+		}
+
+		lastPage.count--;
+		entities.pop_back();
+		GetSparseEntry(aId) = NullIndex;
+
+		// Release the last page once it is empty
+		if (entities.size() % ComponentsPerPage == 0)
+		{
+			m_pages.pop_back();
+		}
 	}
 
 	template<typename T>
 	inline T& ComponentPool::GetComponent(EntityId aId)
 	{
 		assert(HasComponent(aId));
-		return *reinterpret_cast<T*>(&m_pool.at(m_toEntityMap.at(aId)));
+		CheckComponentLayout();
+		WIRE_STATS(m_counters.gets.Add());
+		return GetComponentAt<T>(GetDenseIndex(aId));
+	}
+
+	template<typename T>
+	inline T& ComponentPool::GetComponentAt(uint32_t aDenseIndex)
+	{
+		assert(!HasColumnLayout());
+
+		if constexpr (!std::is_const_v<T>)
+		{
+			StampVersion(aDenseIndex);
+			return *reinterpret_cast<T*>(GetWritableComponentPtr(aDenseIndex));
+		}
+		else
+		{
+			return *reinterpret_cast<T*>(GetComponentPtr(aDenseIndex));
+		}
+	}
+
+	template<typename T, typename F>
+	inline void ComponentPool::ForEachChanged(uint64_t aSinceTick, F&& func)
+	{
+		assert(m_trackChanges);
+		CheckComponentLayout();
+
+		const std::span<const EntityId> entities = GetComponentView();
+		for (size_t i = 0; i < entities.size(); i++)
+		{
+			if (GetVersion(i) >= aSinceTick)
+			{
+				func(entities[i], *reinterpret_cast<T*>(GetWritableComponentPtr(i)));
+			}
+		}
+	}
+
+	template<typename T, typename ... Args>
+	inline std::shared_ptr<T> ComponentPool::MakeShared(Args&&... args) const
+	{
+		return std::allocate_shared<T>(std::pmr::polymorphic_allocator<T>(GetMemoryResource()), std::forward<Args>(args)...);
+	}
+
+	inline void ComponentPool::CheckComponentLayout() const
+	{
+		if (HasColumnLayout())
+		{
+			throw std::logic_error("Typed component access is not available for a pool with a column layout");
+		}
+	}
+
+	inline void ComponentPool::CheckTriviallyCopyable() const
+	{
+		if (m_ops)
+		{
+			throw std::logic_error("Components with ComponentOps can not be written from raw bytes");
+		}
+	}
+
+	inline void ComponentPool::CheckComponentSize(size_t aSize) const
+	{
+		if (aSize != m_componentSize)
+		{
+			throw std::logic_error("Component data does not match the size of the pool's components");
+		}
 	}
 
 	inline std::vector<uint8_t> ComponentPool::GetComponentData(EntityId aId) const
@@ -94,13 +421,161 @@ namespace Wire
 		std::vector<uint8_t> data;
 		data.resize(m_componentSize);
 
-		memcpy_s(data.data(), m_componentSize, &m_pool[m_toEntityMap.at(aId)], m_componentSize);
+		CopyComponentData(aId, data);
 		return data;
 	}
 
+	inline std::span<const uint8_t> ComponentPool::GetComponentBytes(EntityId aId) const
+	{
+		assert(HasComponent(aId));
+		CheckComponentLayout();
+		WIRE_STATS(m_counters.gets.Add());
+		return std::span<const uint8_t>(GetComponentPtr(GetDenseIndex(aId)), m_componentSize);
+	}
+
+	inline std::span<uint8_t> ComponentPool::GetComponentBytes(EntityId aId)
+	{
+		assert(HasComponent(aId));
+		CheckComponentLayout();
+		WIRE_STATS(m_counters.gets.Add());
+		const uint32_t denseIndex = GetDenseIndex(aId);
+		StampVersion(denseIndex);
+
+		return std::span<uint8_t>(GetWritableComponentPtr(denseIndex), m_componentSize);
+	}
+
 	inline bool ComponentPool::HasComponent(EntityId aId) const
 	{
-		auto it = m_toEntityMap.find(aId);
-		return it != m_toEntityMap.end();
+		return GetDenseIndex(aId) != NullIndex;
+	}
+
+	inline void ComponentPool::MarkChanged(EntityId aId)
+	{
+		assert(HasComponent(aId));
+		StampVersion(GetDenseIndex(aId));
+	}
+
+	inline uint64_t ComponentPool::GetVersion(size_t aDenseIndex) const
+	{
+		if (!m_trackChanges)
+		{
+			return 0;
+		}
+
+		return m_pages[aDenseIndex / ComponentsPerPage]->versions[aDenseIndex % ComponentsPerPage];
+	}
+
+	inline void ComponentPool::StampVersion(size_t aDenseIndex)
+	{
+		if (m_trackChanges)
+		{
+			GetWritablePage(aDenseIndex / ComponentsPerPage).versions[aDenseIndex % ComponentsPerPage] = m_currentTick;
+		}
+	}
+
+	inline const uint8_t* ComponentPool::GetComponentPtr(size_t aDenseIndex) const
+	{
+		return m_pages[aDenseIndex / ComponentsPerPage]->data + (aDenseIndex % ComponentsPerPage) * m_componentSize;
+	}
+
+	inline uint8_t* ComponentPool::GetWritableComponentPtr(size_t aDenseIndex)
+	{
+		return GetWritablePage(aDenseIndex / ComponentsPerPage).data + (aDenseIndex % ComponentsPerPage) * m_componentSize;
+	}
+
+	inline ComponentPool::Page& ComponentPool::GetWritablePage(size_t aPageIndex)
+	{
+		std::shared_ptr<Page>& page = m_pages[aPageIndex];
+		if (page.use_count() > 1)
+		{
+			page = MakeShared<Page>(*page);
+			WIRE_STATS(m_counters.pageCopies.Add());
+		}
+
+		return *page;
+	}
+
+	inline ComponentPool::EntityList& ComponentPool::GetWritableEntities()
+	{
+		if (!m_entitiesWithComponent)
+		{
+			m_entitiesWithComponent = MakeShared<EntityList>();
+		}
+		else if (m_entitiesWithComponent.use_count() > 1)
+		{
+			m_entitiesWithComponent = MakeShared<EntityList>(*m_entitiesWithComponent);
+			WIRE_STATS(m_counters.denseReallocations.Add());
+		}
+
+		return *m_entitiesWithComponent;
+	}
+
+	template<typename F>
+	inline void ComponentPool::ForEachUnsharedEntity(const ComponentPool& aClone, F&& func) const
+	{
+		// Adding or removing a component writes the entity list, a shared list means nothing was added or removed
+		if (!m_entitiesWithComponent || m_entitiesWithComponent == aClone.m_entitiesWithComponent)
+		{
+			return;
+		}
+
+		for (size_t page = 0; page < m_sparse.size(); page++)
+		{
+			if (!m_sparse[page] || (page < aClone.m_sparse.size() && m_sparse[page] == aClone.m_sparse[page]))
+			{
+				continue;
+			}
+
+			for (const uint32_t denseIndex : *m_sparse[page])
+			{
+				if (denseIndex != NullIndex)
+				{
+					func((*m_entitiesWithComponent)[denseIndex]);
+				}
+			}
+		}
+	}
+
+	inline uint32_t ComponentPool::GetDenseIndex(EntityId aId) const
+	{
+		const uint32_t index = Entity::GetIndex(aId);
+		const size_t page = index / SparsePageSize;
+		if (page >= m_sparse.size() || !m_sparse[page])
+		{
+			return NullIndex;
+		}
+
+		// The sparse set is keyed on the slot index, a stale handle to the same slot does not match the dense entry
+		const uint32_t denseIndex = (*m_sparse[page])[index % SparsePageSize];
+		if (denseIndex == NullIndex || (*m_entitiesWithComponent)[denseIndex] != aId)
+		{
+			return NullIndex;
+		}
+
+		return denseIndex;
+	}
+
+	inline uint32_t& ComponentPool::GetSparseEntry(EntityId aId)
+	{
+		const uint32_t index = Entity::GetIndex(aId);
+		const size_t page = index / SparsePageSize;
+		if (page >= m_sparse.size())
+		{
+			m_sparse.resize(page + 1);
+		}
+
+		std::shared_ptr<SparsePage>& sparsePage = m_sparse[page];
+		if (!sparsePage)
+		{
+			sparsePage = MakeShared<SparsePage>(SparsePageSize, NullIndex);
+			WIRE_STATS(m_counters.sparsePageAllocations.Add());
+		}
+		else if (sparsePage.use_count() > 1)
+		{
+			sparsePage = MakeShared<SparsePage>(*sparsePage);
+			WIRE_STATS(m_counters.pageCopies.Add());
+		}
+
+		return (*sparsePage)[index % SparsePageSize];
 	}
 }
\ No newline at end of file
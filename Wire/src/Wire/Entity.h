@@ -6,4 +6,21 @@ namespace Wire
 {
 	typedef uint32_t EntityId;
 	static const EntityId NullID = 0;
+
+	/*
+	* An EntityId is a handle: the lower bits index the entity slot and the upper bits store the
+	* generation of that slot. The generation is bumped every time the slot is freed, so handles
+	* to a destroyed entity are detected even after the slot has been reused.
+	*/
+	namespace Entity
+	{
+		static constexpr uint32_t IndexBits = 22;
+		static constexpr uint32_t VersionBits = 32 - IndexBits;
+		static constexpr uint32_t IndexMask = (1u << IndexBits) - 1;
+		static constexpr uint32_t VersionMask = (1u << VersionBits) - 1;
+
+		constexpr uint32_t GetIndex(EntityId aId) { return aId & IndexMask; }
+		constexpr uint32_t GetVersion(EntityId aId) { return aId >> IndexBits; }
+		constexpr EntityId Compose(uint32_t aIndex, uint32_t aVersion) { return (aIndex & IndexMask) | ((aVersion & VersionMask) << IndexBits); }
+	}
 }
\ No newline at end of file
@@ -0,0 +1,205 @@
+#include "JobSystem.h"
+
+#include <algorithm>
+
+namespace Wire
+{
+	namespace Utility
+	{
+		thread_local uint32_t s_currentThreadIndex = 0;
+	}
+
+	JobSystem::JobSystem(uint32_t aThreadCount)
+	{
+		aThreadCount = std::max(aThreadCount, 1u);
+
+		for (uint32_t i = 0; i < aThreadCount; i++)
+		{
+			m_queues.emplace_back(std::make_unique<WorkQueue>());
+		}
+
+		for (uint32_t i = 1; i < aThreadCount; i++)
+		{
+			m_workers.emplace_back(&JobSystem::WorkerLoop, this, i);
+		}
+	}
+
+	JobSystem::~JobSystem()
+	{
+		{
+			std::lock_guard lock(m_wakeMutex);
+			m_running = false;
+		}
+
+		m_wakeCondition.notify_all();
+
+		for (auto& worker : m_workers)
+		{
+			worker.join();
+		}
+	}
+
+	void JobSystem::ParallelFor(size_t aCount, size_t aChunkSize, const RangeFunction& func)
+	{
+		if (aCount == 0)
+		{
+			return;
+		}
+
+		aChunkSize = std::max(aChunkSize, (size_t)1);
+		const size_t chunkCount = (aCount + aChunkSize - 1) / aChunkSize;
+
+		if (chunkCount == 1 || m_workers.empty())
+		{
+			func(0, aCount);
+			return;
+		}
+
+		Batch batch;
+		batch.remaining = chunkCount;
+		m_queuedJobs += chunkCount;
+
+		for (size_t chunk = 0; chunk < chunkCount; chunk++)
+		{
+			Job job;
+			job.function = &func;
+			job.begin = chunk * aChunkSize;
+			job.end = std::min(job.begin + aChunkSize, aCount);
+			job.batch = &batch;
+
+			WorkQueue& queue = *m_queues[chunk % m_queues.size()];
+			std::lock_guard lock(queue.mutex);
+			queue.jobs.emplace_back(job);
+		}
+
+		{
+			std::lock_guard lock(m_wakeMutex);
+		}
+		m_wakeCondition.notify_all();
+
+		// Help out until every chunk of this call has finished, queued jobs point to batch and func until then
+		while (batch.remaining.load(std::memory_order_acquire) > 0)
+		{
+			Job job;
+			if (TryGetJob(0, job))
+			{
+				Execute(job);
+			}
+			else
+			{
+				std::this_thread::yield();
+			}
+		}
+
+		if (batch.exception)
+		{
+			std::rethrow_exception(batch.exception);
+		}
+	}
+
+	JobSystem& JobSystem::GetDefault()
+	{
+		static JobSystem jobSystem;
+		return jobSystem;
+	}
+
+	uint32_t JobSystem::GetCurrentThreadIndex()
+	{
+		return Utility::s_currentThreadIndex;
+	}
+
+	bool JobSystem::TryPop(uint32_t aQueueIndex, Job& outJob)
+	{
+		WorkQueue& queue = *m_queues[aQueueIndex];
+		std::lock_guard lock(queue.mutex);
+
+		if (queue.jobs.empty())
+		{
+			return false;
+		}
+
+		outJob = queue.jobs.back();
+		queue.jobs.pop_back();
+		return true;
+	}
+
+	bool JobSystem::TrySteal(uint32_t aThiefIndex, Job& outJob)
+	{
+		const uint32_t queueCount = (uint32_t)m_queues.size();
+
+		for (uint32_t i = 1; i < queueCount; i++)
+		{
+			WorkQueue& queue = *m_queues[(aThiefIndex + i) % queueCount];
+			std::lock_guard lock(queue.mutex);
+
+			if (!queue.jobs.empty())
+			{
+				outJob = queue.jobs.front();
+				queue.jobs.pop_front();
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	bool JobSystem::TryGetJob(uint32_t aQueueIndex, Job& outJob)
+	{
+		if (TryPop(aQueueIndex, outJob) || TrySteal(aQueueIndex, outJob))
+		{
+			m_queuedJobs--;
+			return true;
+		}
+
+		return false;
+	}
+
+	void JobSystem::Execute(const Job& job)
+	{
+		Batch& batch = *job.batch;
+
+		// Exceptions are handed to the calling thread, the chunk counts as finished either way
+		if (!batch.failed.load(std::memory_order_relaxed))
+		{
+			try
+			{
+				(*job.function)(job.begin, job.end);
+			}
+			catch (...)
+			{
+				std::lock_guard lock(batch.exceptionMutex);
+				if (!batch.exception)
+				{
+					batch.exception = std::current_exception();
+					batch.failed = true;
+				}
+			}
+		}
+
+		// The last access to the batch, ParallelFor may return right after
+		batch.remaining.fetch_sub(1, std::memory_order_release);
+	}
+
+	void JobSystem::WorkerLoop(uint32_t aQueueIndex)
+	{
+		Utility::s_currentThreadIndex = aQueueIndex;
+
+		while (true)
+		{
+			Job job;
+			if (TryGetJob(aQueueIndex, job))
+			{
+				Execute(job);
+				continue;
+			}
+
+			std::unique_lock lock(m_wakeMutex);
+			m_wakeCondition.wait(lock, [this]() { return m_queuedJobs > 0 || !m_running; });
+
+			if (!m_running)
+			{
+				break;
+			}
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Wire
+{
+	/*
+	* A small work-stealing thread pool.
+	* Every thread owns a queue, jobs are pushed round robin and idle threads steal from the front of other queues.
+	* The thread calling ParallelFor takes part in the work until its jobs are done.
+	*/
+	class JobSystem
+	{
+	public:
+		using RangeFunction = std::function<void(size_t, size_t)>;
+
+		// The thread count includes the calling thread, a count of 1 runs everything inline
+		explicit JobSystem(uint32_t aThreadCount = std::thread::hardware_concurrency());
+		JobSystem(const JobSystem&) = delete;
+		~JobSystem();
+
+		JobSystem& operator=(const JobSystem&) = delete;
+
+		/*
+		* Splits [0, aCount) into chunks of aChunkSize and calls func(begin, end) for each, blocks until all are done.
+		* If func throws, chunks that have not started yet are skipped and the first exception is rethrown on the
+		* calling thread once no chunk is running anymore.
+		*/
+		void ParallelFor(size_t aCount, size_t aChunkSize, const RangeFunction& func);
+
+		inline const uint32_t GetThreadCount() const { return (uint32_t)m_queues.size(); }
+
+		static JobSystem& GetDefault();
+
+		// Index of the worker running the calling code, 0 for threads that are not workers of a job system
+		static uint32_t GetCurrentThreadIndex();
+
+	private:
+		// The state of one ParallelFor call, lives on the calling thread's stack until every chunk has finished
+		struct Batch
+		{
+			std::atomic<size_t> remaining = 0;
+			std::atomic<bool> failed = false;
+			std::mutex exceptionMutex;
+			std::exception_ptr exception;
+		};
+
+		struct Job
+		{
+			const RangeFunction* function = nullptr;
+			size_t begin = 0;
+			size_t end = 0;
+			Batch* batch = nullptr;
+		};
+
+		struct WorkQueue
+		{
+			std::mutex mutex;
+			std::deque<Job> jobs;
+		};
+
+		bool TryPop(uint32_t aQueueIndex, Job& outJob);
+		bool TrySteal(uint32_t aThiefIndex, Job& outJob);
+		bool TryGetJob(uint32_t aQueueIndex, Job& outJob);
+
+		void Execute(const Job& job);
+		void WorkerLoop(uint32_t aQueueIndex);
+
+		// Queue zero belongs to the threads calling ParallelFor
+		std::vector<std::unique_ptr<WorkQueue>> m_queues;
+		std::vector<std::thread> m_workers;
+
+		std::mutex m_wakeMutex;
+		std::condition_variable m_wakeCondition;
+		std::atomic<size_t> m_queuedJobs = 0;
+		std::atomic<bool> m_running = true;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,98 @@
+#include "OwningGroup.h"
+#include "ComponentPool.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace Wire
+{
+	OwningGroup::OwningGroup(std::span<ComponentPool* const> aPools)
+		: m_pools(aPools.begin(), aPools.end(), aPools.front()->GetMemoryResource())
+	{
+		// Checked before any pool is taken, so a rejected group leaves the pools and their current group untouched
+		for (auto it = aPools.begin(); it != aPools.end(); it++)
+		{
+			if ((*it)->GetGroup() || std::find(aPools.begin(), it, *it) != it)
+			{
+				throw std::logic_error("A pool can only be owned by one group");
+			}
+		}
+
+		const ComponentPool* smallestPool = nullptr;
+		for (ComponentPool* pool : m_pools)
+		{
+			pool->SetGroup(this);
+
+			if (!smallestPool || pool->GetComponentView().size() < smallestPool->GetComponentView().size())
+			{
+				smallestPool = pool;
+			}
+		}
+
+		if (!smallestPool)
+		{
+			return;
+		}
+
+		// Packing moves entries of the smallest pool, so walk a copy of its entities
+		const std::span<const EntityId> view = smallestPool->GetComponentView();
+		const std::vector<EntityId> entities(view.begin(), view.end());
+		for (const EntityId id : entities)
+		{
+			OnComponentAdded(id);
+		}
+	}
+
+	OwningGroup::OwningGroup(const OwningGroup& aGroup, std::span<ComponentPool* const> aPools)
+		: m_pools(aPools.begin(), aPools.end(), aPools.front()->GetMemoryResource()), m_size(aGroup.m_size)
+	{
+		for (ComponentPool* pool : m_pools)
+		{
+			pool->SetGroup(this);
+		}
+	}
+
+	void OwningGroup::OnComponentAdded(EntityId aId)
+	{
+		if (Contains(aId))
+		{
+			return;
+		}
+
+		for (const ComponentPool* pool : m_pools)
+		{
+			if (!pool->HasComponent(aId))
+			{
+				return;
+			}
+		}
+
+		for (ComponentPool* pool : m_pools)
+		{
+			pool->SwapDense(pool->GetDenseIndex(aId), m_size);
+		}
+
+		m_size++;
+	}
+
+	void OwningGroup::OnComponentRemoving(EntityId aId)
+	{
+		if (!Contains(aId))
+		{
+			return;
+		}
+
+		// Move the entity to the end of the group, the pool's swap-remove then only touches entries outside of it
+		m_size--;
+		for (ComponentPool* pool : m_pools)
+		{
+			pool->SwapDense(pool->GetDenseIndex(aId), m_size);
+		}
+	}
+
+	bool OwningGroup::Contains(EntityId aId) const
+	{
+		const uint32_t denseIndex = m_pools.front()->GetDenseIndex(aId);
+		return denseIndex != ComponentPool::NullIndex && denseIndex < m_size;
+	}
+}
\ No newline at end of file
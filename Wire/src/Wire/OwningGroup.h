@@ -0,0 +1,45 @@
+#pragma once
+
+#include "Entity.h"
+
+#include <vector>
+#include <memory_resource>
+#include <span>
+#include <cstddef>
+
+namespace Wire
+{
+	class ComponentPool;
+
+	/*
+	* Keeps the entities that have a component in every owned pool packed at the front of those pools, in the same order.
+	* The pools notify the group when components are added or removed, so the first GetSize() dense entries of every
+	* owned pool always belong to the same entities and can be walked in lock step.
+	* The pool list is allocated from the memory resource of the first pool.
+	*/
+	class OwningGroup
+	{
+	public:
+		// Takes ownership of the pools and packs the entities they have in common, throws std::logic_error if a pool already has a group
+		OwningGroup(std::span<ComponentPool* const> aPools);
+
+		// Owns aPools, which must be copies of aGroup's pools in the same dense order
+		OwningGroup(const OwningGroup& aGroup, std::span<ComponentPool* const> aPools);
+
+		OwningGroup(const OwningGroup&) = delete;
+
+		OwningGroup& operator=(const OwningGroup&) = delete;
+
+		void OnComponentAdded(EntityId aId);
+		void OnComponentRemoving(EntityId aId);
+
+		bool Contains(EntityId aId) const;
+
+		inline const size_t GetSize() const { return m_size; }
+		inline std::span<ComponentPool* const> GetPools() const { return m_pools; }
+
+	private:
+		std::pmr::vector<ComponentPool*> m_pools;
+		uint32_t m_size = 0;
+	};
+}
\ No newline at end of file
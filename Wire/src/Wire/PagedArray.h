@@ -0,0 +1,188 @@
+#pragma once
+
+#include <memory>
+#include <memory_resource>
+#include <vector>
+#include <algorithm>
+#include <cassert>
+#include <utility>
+
+namespace Wire
+{
+	/*
+	* An array stored in fixed size pages that clones share, like the pages of a ComponentPool. A page is copied the
+	* first time an array writes to it while it is shared, so cloning costs one pointer per page.
+	* Copying or assigning copies the pages into the memory resource of the target.
+	*/
+	template<typename T, size_t PageSize>
+	class PagedArray
+	{
+	public:
+		explicit PagedArray(std::pmr::memory_resource* aResource = std::pmr::get_default_resource());
+		PagedArray(const PagedArray& array);
+		PagedArray(PagedArray&& array);
+
+		PagedArray& operator=(const PagedArray& array);
+		PagedArray& operator=(PagedArray&& array);
+
+		// Returns an array sharing all pages with this one
+		PagedArray Clone() const;
+
+		inline const T& operator[](size_t aIndex) const { return (*m_pages[aIndex / PageSize])[aIndex % PageSize]; }
+		T& GetWritable(size_t aIndex);
+
+		inline const T& Back() const { return (*this)[m_size - 1]; }
+
+		// Elements added by growing are value initialized
+		void Resize(size_t aSize);
+		T& EmplaceBack();
+		void PopBack();
+		void Clear();
+
+		inline const size_t GetSize() const { return m_size; }
+		inline const bool IsEmpty() const { return m_size == 0; }
+		inline const size_t GetPageCount() const { return m_pages.size(); }
+
+		// A page still shared with aClone was not written by either array since cloning
+		inline const bool SharesPage(const PagedArray& aClone, size_t aPageIndex) const { return aPageIndex < m_pages.size() && aPageIndex < aClone.m_pages.size() && m_pages[aPageIndex] == aClone.m_pages[aPageIndex]; }
+		inline std::pmr::memory_resource* GetMemoryResource() const { return m_pages.get_allocator().resource(); }
+
+		static constexpr size_t ElementsPerPage = PageSize;
+
+	private:
+		using Page = std::pmr::vector<T>;
+
+		std::shared_ptr<Page> CreatePage() const;
+
+		std::pmr::vector<std::shared_ptr<Page>> m_pages;
+		size_t m_size = 0;
+	};
+
+	template<typename T, size_t PageSize>
+	inline PagedArray<T, PageSize>::PagedArray(std::pmr::memory_resource* aResource)
+		: m_pages(aResource)
+	{
+	}
+
+	template<typename T, size_t PageSize>
+	inline PagedArray<T, PageSize>::PagedArray(const PagedArray& array)
+		: m_pages(array.GetMemoryResource())
+	{
+		*this = array;
+	}
+
+	template<typename T, size_t PageSize>
+	inline PagedArray<T, PageSize>::PagedArray(PagedArray&& array)
+		: m_pages(std::move(array.m_pages)), m_size(std::exchange(array.m_size, 0))
+	{
+	}
+
+	template<typename T, size_t PageSize>
+	inline PagedArray<T, PageSize>& PagedArray<T, PageSize>::operator=(PagedArray&& array)
+	{
+		// The pages are taken over as they are, so they stay on the resource of the moved-from array
+		m_pages = std::move(array.m_pages);
+		m_size = std::exchange(array.m_size, 0);
+		array.m_pages.clear();
+
+		return *this;
+	}
+
+	template<typename T, size_t PageSize>
+	inline PagedArray<T, PageSize>& PagedArray<T, PageSize>::operator=(const PagedArray& array)
+	{
+		if (this != &array)
+		{
+			const std::pmr::polymorphic_allocator<Page> allocator(GetMemoryResource());
+
+			m_pages.clear();
+			for (const auto& page : array.m_pages)
+			{
+				m_pages.emplace_back(std::allocate_shared<Page>(allocator, *page));
+			}
+
+			m_size = array.m_size;
+		}
+
+		return *this;
+	}
+
+	template<typename T, size_t PageSize>
+	inline PagedArray<T, PageSize> PagedArray<T, PageSize>::Clone() const
+	{
+		PagedArray array(GetMemoryResource());
+		array.m_pages = m_pages;
+		array.m_size = m_size;
+
+		return array;
+	}
+
+	template<typename T, size_t PageSize>
+	inline T& PagedArray<T, PageSize>::GetWritable(size_t aIndex)
+	{
+		assert(aIndex < m_size);
+
+		std::shared_ptr<Page>& page = m_pages[aIndex / PageSize];
+		if (page.use_count() > 1)
+		{
+			page = std::allocate_shared<Page>(std::pmr::polymorphic_allocator<Page>(GetMemoryResource()), *page);
+		}
+
+		return (*page)[aIndex % PageSize];
+	}
+
+	template<typename T, size_t PageSize>
+	inline void PagedArray<T, PageSize>::Resize(size_t aSize)
+	{
+		const size_t oldSize = m_size;
+		const size_t oldPageCount = m_pages.size();
+		m_pages.resize((aSize + PageSize - 1) / PageSize);
+
+		for (size_t i = oldPageCount; i < m_pages.size(); i++)
+		{
+			m_pages[i] = CreatePage();
+		}
+
+		m_size = aSize;
+
+		// New pages start value initialized, only the tail of the previously last page may hold old elements
+		const size_t firstNewPageIndex = (oldSize + PageSize - 1) / PageSize * PageSize;
+		for (size_t i = oldSize; i < std::min(aSize, firstNewPageIndex); i++)
+		{
+			GetWritable(i) = T{};
+		}
+	}
+
+	template<typename T, size_t PageSize>
+	inline T& PagedArray<T, PageSize>::EmplaceBack()
+	{
+		Resize(m_size + 1);
+		return GetWritable(m_size - 1);
+	}
+
+	template<typename T, size_t PageSize>
+	inline void PagedArray<T, PageSize>::PopBack()
+	{
+		assert(m_size > 0);
+		m_size--;
+
+		if (m_size % PageSize == 0)
+		{
+			m_pages.pop_back();
+		}
+	}
+
+	template<typename T, size_t PageSize>
+	inline void PagedArray<T, PageSize>::Clear()
+	{
+		m_pages.clear();
+		m_size = 0;
+	}
+
+	template<typename T, size_t PageSize>
+	inline std::shared_ptr<typename PagedArray<T, PageSize>::Page> PagedArray<T, PageSize>::CreatePage() const
+	{
+		// Uses allocator construction passes the memory resource on to the page's vector
+		return std::allocate_shared<Page>(std::pmr::polymorphic_allocator<Page>(GetMemoryResource()), PageSize);
+	}
+}
\ No newline at end of file
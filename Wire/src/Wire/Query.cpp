@@ -0,0 +1,96 @@
+#include "Query.h"
+
+namespace Wire
+{
+	QueryCache::QueryCache(std::span<ComponentPool* const> aPools)
+		: m_pools(aPools.begin(), aPools.end(), aPools.front()->GetMemoryResource()), m_entities(aPools.front()->GetMemoryResource()), m_indices(aPools.front()->GetMemoryResource())
+	{
+		// Checked before observing any pool, so a failed query leaves no dangling observer behind
+		for (const ComponentPool* pool : m_pools)
+		{
+			pool->CheckComponentLayout();
+		}
+
+		const ComponentPool* smallestPool = nullptr;
+		for (ComponentPool* pool : m_pools)
+		{
+			pool->AddQuery(this);
+
+			if (!smallestPool || pool->GetComponentView().size() < smallestPool->GetComponentView().size())
+			{
+				smallestPool = pool;
+			}
+		}
+
+		for (const EntityId id : smallestPool->GetComponentView())
+		{
+			OnComponentAdded(id);
+		}
+	}
+
+	QueryCache::QueryCache(const QueryCache& aQuery, std::span<ComponentPool* const> aPools)
+		: m_pools(aPools.begin(), aPools.end(), aPools.front()->GetMemoryResource()), m_entities(aQuery.m_entities, aPools.front()->GetMemoryResource()), m_indices(aQuery.m_indices, aPools.front()->GetMemoryResource())
+	{
+		for (ComponentPool* pool : m_pools)
+		{
+			pool->AddQuery(this);
+		}
+	}
+
+	void QueryCache::OnComponentAdded(EntityId aId)
+	{
+		if (Contains(aId))
+		{
+			return;
+		}
+
+		for (const ComponentPool* pool : m_pools)
+		{
+			if (!pool->HasComponent(aId))
+			{
+				return;
+			}
+		}
+
+		const uint32_t index = Entity::GetIndex(aId);
+		if (index >= m_indices.size())
+		{
+			m_indices.resize((size_t)index + 1, ComponentPool::NullIndex);
+		}
+
+		m_indices[index] = (uint32_t)m_entities.size();
+		m_entities.emplace_back(aId);
+	}
+
+	void QueryCache::OnComponentRemoving(EntityId aId)
+	{
+		if (!Contains(aId))
+		{
+			return;
+		}
+
+		// Move the last entity into the removed one's place
+		const uint32_t index = Entity::GetIndex(aId);
+		const uint32_t position = m_indices[index];
+		const EntityId last = m_entities.back();
+
+		m_entities[position] = last;
+		m_indices[Entity::GetIndex(last)] = position;
+
+		m_entities.pop_back();
+		m_indices[index] = ComponentPool::NullIndex;
+	}
+
+	void QueryCache::Clear()
+	{
+		m_entities.clear();
+		m_indices.clear();
+	}
+
+	bool QueryCache::Contains(EntityId aId) const
+	{
+		// A stale handle to the same slot does not match the stored entity
+		const uint32_t index = Entity::GetIndex(aId);
+		return index < m_indices.size() && m_indices[index] != ComponentPool::NullIndex && m_entities[m_indices[index]] == aId;
+	}
+}
\ No newline at end of file
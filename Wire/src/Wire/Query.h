@@ -0,0 +1,149 @@
+#pragma once
+
+#include "Entity.h"
+#include "ComponentPool.hpp"
+#include "JobSystem.h"
+
+#include <array>
+#include <memory_resource>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace Wire
+{
+	/*
+	* The entities that have a component in every pool. The pools notify the cache when components are added or
+	* removed, matching costs a lookup per pool on add and leaving the cache costs a swap, so the list never has to be
+	* rebuilt. The pool and entity lists are allocated from the memory resource of the first pool.
+	*/
+	class QueryCache
+	{
+	public:
+		// Observes the pools and collects the entities they have in common
+		QueryCache(std::span<ComponentPool* const> aPools);
+
+		// Observes aPools, which must be copies of aQuery's pools
+		QueryCache(const QueryCache& aQuery, std::span<ComponentPool* const> aPools);
+
+		QueryCache(const QueryCache&) = delete;
+
+		QueryCache& operator=(const QueryCache&) = delete;
+
+		void OnComponentAdded(EntityId aId);
+		void OnComponentRemoving(EntityId aId);
+
+		// Called when one of the pools lost all of its components
+		void Clear();
+
+		bool Contains(EntityId aId) const;
+
+		inline std::span<const EntityId> GetEntities() const { return m_entities; }
+		inline std::span<ComponentPool* const> GetPools() const { return m_pools; }
+
+	private:
+		std::pmr::vector<ComponentPool*> m_pools;
+		std::pmr::vector<EntityId> m_entities;
+		std::pmr::vector<uint32_t> m_indices; // Index into m_entities by entity slot, NullIndex if the entity does not match
+	};
+
+	/*
+	* A handle to a cached query over the entities that have every component in T, see Registry::GetQuery.
+	* Unlike a View it does not test candidates, it visits exactly the matching entities and looks up their components.
+	* Like views, queries over a pool with a column layout throw std::logic_error on creation.
+	*/
+	template<typename ... T>
+	class Query
+	{
+	public:
+		Query() = default;
+		Query(const QueryCache* aCache, const std::array<ComponentPool*, sizeof...(T)>& aPools);
+
+		template<typename F>
+		void ForEach(F&& func) const;
+
+		// Splits the entities into chunks of aChunkSize, func is called concurrently and must not add or remove entities or components
+		template<typename F>
+		void ParallelForEach(F&& func, JobSystem& jobSystem, size_t aChunkSize = 1024) const;
+
+		inline bool Contains(EntityId aId) const { return m_cache && m_cache->Contains(aId); }
+		inline std::span<const EntityId> GetEntities() const { return m_cache ? m_cache->GetEntities() : std::span<const EntityId>(); }
+		inline const size_t GetSize() const { return GetEntities().size(); }
+
+	private:
+		template<typename F, size_t ... I>
+		void ForEachInRange(F& func, size_t aBegin, size_t aEnd, std::index_sequence<I...>) const;
+
+		template<size_t ... I>
+		void MakePoolsUnique(std::index_sequence<I...>) const;
+
+		const QueryCache* m_cache = nullptr;
+		std::array<ComponentPool*, sizeof...(T)> m_pools{};
+	};
+
+	template<typename ...T>
+	inline Query<T...>::Query(const QueryCache* aCache, const std::array<ComponentPool*, sizeof...(T)>& aPools)
+		: m_cache(aCache), m_pools(aPools)
+	{
+		for (const ComponentPool* pool : m_pools)
+		{
+			pool->CheckComponentLayout();
+		}
+	}
+
+	template<typename ...T>
+	template<typename F>
+	inline void Query<T...>::ForEach(F&& func) const
+	{
+		const std::span<const EntityId> entities = GetEntities();
+
+		// Iterate backwards so that removing the current entity's components does not skip any entity
+		for (size_t i = entities.size(); i > 0; i--)
+		{
+			ForEachInRange(func, i - 1, i, std::index_sequence_for<T...>{});
+		}
+	}
+
+	template<typename ...T>
+	template<typename F>
+	inline void Query<T...>::ParallelForEach(F&& func, JobSystem& jobSystem, size_t aChunkSize) const
+	{
+		if (!m_cache)
+		{
+			return;
+		}
+
+		// Pages shared with a clone would otherwise be copied from several threads at once
+		MakePoolsUnique(std::index_sequence_for<T...>{});
+
+		jobSystem.ParallelFor(GetSize(), aChunkSize, [this, &func](size_t begin, size_t end)
+			{
+				ForEachInRange(func, begin, end, std::index_sequence_for<T...>{});
+			});
+	}
+
+	template<typename ...T>
+	template<typename F, size_t ...I>
+	inline void Query<T...>::ForEachInRange(F& func, size_t aBegin, size_t aEnd, std::index_sequence<I...>) const
+	{
+		const std::span<const EntityId> entities = m_cache->GetEntities();
+		for (size_t i = aBegin; i < aEnd; i++)
+		{
+			const EntityId id = entities[i];
+			func(id, m_pools[I]->template GetComponentAt<T>(m_pools[I]->GetDenseIndex(id))...);
+		}
+	}
+
+	template<typename ...T>
+	template<size_t ...I>
+	inline void Query<T...>::MakePoolsUnique(std::index_sequence<I...>) const
+	{
+		([this]()
+			{
+				if constexpr (!std::is_const_v<T>)
+				{
+					m_pools[I]->MakeUnique();
+				}
+			}(), ...);
+	}
+}
\ No newline at end of file
@@ -2,93 +2,674 @@
 
 #include "Serialization.h"
 
+#include <algorithm>
+#include <stdexcept>
+
 namespace Wire
 {
+	Registry::Registry()
+		: Registry(std::pmr::get_default_resource())
+	{
+	}
+
+	Registry::Registry(std::pmr::memory_resource* aResource)
+		: m_pools(aResource), m_typedPools(aResource), m_entitySlots(aResource), m_availiableSlots(aResource), m_hierarchy(aResource),
+		m_groups(aResource), m_queries(aResource)
+	{
+		m_entitySlots.EmplaceBack();
+	}
+
 	Registry::Registry(const Registry& registry)
+		: Registry(registry.GetMemoryResource())
+	{
+		*this = registry;
+	}
+
+	Registry& Registry::operator=(const Registry& registry)
+	{
+		if (this != &registry)
+		{
+			m_entitySlots = registry.m_entitySlots;
+			m_availiableSlots = registry.m_availiableSlots;
+			m_usedIds = registry.m_usedIds ? std::allocate_shared<EntityList>(std::pmr::polymorphic_allocator<EntityList>(GetMemoryResource()), *registry.m_usedIds) : nullptr;
+			m_hierarchy = registry.m_hierarchy;
+			m_groups.clear();
+			m_queries.clear();
+			m_typedPools.clear();
+
+			// Copy the pools into this registry's memory resource
+			m_pools.clear();
+			for (const auto& [guid, pool] : registry.m_pools)
+			{
+				m_pools.try_emplace(guid, pool, GetMemoryResource());
+			}
+
+			m_currentTick = registry.m_currentTick;
+
+			CopyGroups(registry);
+			CopyQueries(registry);
+		}
+
+		return *this;
+	}
+
+	Registry& Registry::operator=(Registry&& registry)
+	{
+		if (this == &registry)
+		{
+			return *this;
+		}
+
+		// Containers can only take over storage from an equal resource, moving element by element would leave
+		// the typed pool cache, the groups and the queries pointing into the other registry
+		if (!(*GetMemoryResource() == *registry.GetMemoryResource()))
+		{
+			*this = registry;
+			registry.Clear();
+			return *this;
+		}
+
+		ClearComponents();
+		m_pools = std::move(registry.m_pools);
+		m_typedPools = std::move(registry.m_typedPools);
+		m_currentTick = registry.m_currentTick;
+		m_entitySlots = std::move(registry.m_entitySlots);
+		m_availiableSlots = std::move(registry.m_availiableSlots);
+		m_usedIds = std::move(registry.m_usedIds);
+		m_hierarchy = std::move(registry.m_hierarchy);
+		m_groups.swap(registry.m_groups);
+		m_queries.swap(registry.m_queries);
+		WIRE_STATS(m_counters = registry.m_counters;)
+
+		registry.Clear();
+		return *this;
+	}
+
+	Registry Registry::Clone() const
 	{
-		m_nextEntityId = registry.m_nextEntityId;
-		m_availiableIds = registry.m_availiableIds;
-		m_pools = registry.m_pools;
+		Registry registry(GetMemoryResource());
+		registry.m_entitySlots = m_entitySlots.Clone();
+		registry.m_availiableSlots = m_availiableSlots.Clone();
+		registry.m_usedIds = m_usedIds;
+		registry.m_hierarchy = m_hierarchy.Clone();
+		registry.m_currentTick = m_currentTick;
+
+		for (const auto& [guid, pool] : m_pools)
+		{
+			registry.m_pools.emplace(guid, pool.Clone());
+		}
+
+		registry.CopyGroups(*this);
+		registry.CopyQueries(*this);
+		return registry;
 	}
 
 	Registry::~Registry()
 	{
-		Clear();
+		ClearComponents();
 	}
 
 	EntityId Registry::CreateEntity()
 	{
-		EntityId id;
-		if (!m_availiableIds.empty())
+		uint32_t index = NullIndex;
+
+		// AddEntity can claim a slot that is still in the free list, those entries are skipped here
+		while (!m_availiableSlots.IsEmpty())
 		{
-			id = m_availiableIds.back();
-			m_availiableIds.pop_back();
+			const uint32_t slotIndex = m_availiableSlots.Back();
+			m_availiableSlots.PopBack();
+
+			if (m_entitySlots[slotIndex].usedIndex == NullIndex)
+			{
+				index = slotIndex;
+				break;
+			}
 		}
-		else
+
+		if (index == NullIndex)
 		{
-			id = m_nextEntityId++;
+			index = (uint32_t)m_entitySlots.GetSize();
+			assert(index <= Entity::IndexMask);
+
+			m_entitySlots.EmplaceBack();
 		}
-		
-		m_usedIds.emplace_back(id);
+
+		EntityList& usedIds = GetWritableUsedIds();
+		EntitySlot& slot = m_entitySlots.GetWritable(index);
+		const EntityId id = Entity::Compose(index, slot.version);
+
+		slot.usedIndex = (uint32_t)usedIds.size();
+		usedIds.emplace_back(id);
+		WIRE_STATS(m_counters.creates.Add());
 
 		return id;
 	}
 
+	void Registry::CreateEntities(size_t aCount, std::span<EntityId> outIds)
+	{
+		assert(outIds.size() >= aCount);
+		WIRE_STATS(m_counters.creates.Add(aCount));
+
+		EntityList& usedIds = GetWritableUsedIds();
+		usedIds.reserve(usedIds.size() + aCount);
+
+		size_t created = 0;
+		while (created < aCount && !m_availiableSlots.IsEmpty())
+		{
+			const uint32_t slotIndex = m_availiableSlots.Back();
+			m_availiableSlots.PopBack();
+
+			if (m_entitySlots[slotIndex].usedIndex != NullIndex)
+			{
+				continue;
+			}
+
+			EntitySlot& slot = m_entitySlots.GetWritable(slotIndex);
+			slot.usedIndex = (uint32_t)usedIds.size();
+
+			outIds[created] = usedIds.emplace_back(Entity::Compose(slotIndex, slot.version));
+			created++;
+		}
+
+		// The rest get new slots at the end
+		const size_t firstIndex = m_entitySlots.GetSize();
+		assert(firstIndex + (aCount - created) - 1 <= Entity::IndexMask);
+
+		m_entitySlots.Resize(firstIndex + (aCount - created));
+		for (size_t index = firstIndex; created < aCount; index++, created++)
+		{
+			EntitySlot& slot = m_entitySlots.GetWritable(index);
+			slot.usedIndex = (uint32_t)usedIds.size();
+			outIds[created] = usedIds.emplace_back(Entity::Compose((uint32_t)index, slot.version));
+		}
+	}
+
 	EntityId Registry::AddEntity(EntityId aId)
 	{
-		assert(aId != 0);
-		assert(std::find(m_usedIds.begin(), m_usedIds.end(), aId) == m_usedIds.end());
+		const uint32_t index = Entity::GetIndex(aId);
+		if (aId == NullID || (index < m_entitySlots.GetSize() && m_entitySlots[index].usedIndex != NullIndex))
+		{
+			return NullID;
+		}
 
-		if (m_nextEntityId <= aId)
+		if (index >= m_entitySlots.GetSize())
 		{
-			m_nextEntityId = aId + 1;
+			const uint32_t oldSize = (uint32_t)m_entitySlots.GetSize();
+			m_entitySlots.Resize(index + 1);
+
+			for (uint32_t i = oldSize; i < index; i++)
+			{
+				m_availiableSlots.EmplaceBack() = i;
+			}
 		}
 
-		m_usedIds.emplace_back(aId);
+		EntityList& usedIds = GetWritableUsedIds();
+		EntitySlot& slot = m_entitySlots.GetWritable(index);
+		slot.version = Entity::GetVersion(aId);
+		slot.usedIndex = (uint32_t)usedIds.size();
+		usedIds.emplace_back(aId);
+		WIRE_STATS(m_counters.creates.Add());
 
 		return aId;
 	}
 
-	void Registry::AddChild(EntityId parent, EntityId child)
+	uint64_t Registry::AdvanceTick()
 	{
-		assert(std::find(m_usedIds.begin(), m_usedIds.end(), parent) != m_usedIds.end());
-		assert(std::find(m_usedIds.begin(), m_usedIds.end(), child) != m_usedIds.end());
+		m_currentTick++;
 
-		auto& children = m_childEntities[parent];
-		if (std::find(children.begin(), children.end(), child) == children.end())
+		for (auto& [guid, pool] : m_pools)
 		{
-			children.emplace_back(child);
+			pool.SetCurrentTick(m_currentTick);
 		}
+
+		return m_currentTick;
 	}
 
+	void Registry::AddChild(EntityId parent, EntityId child)
+	{
+		assert(IsValid(parent));
+		assert(IsValid(child));
+		assert(parent != child);
+
+		if (GetParent(child) == parent)
+		{
+			return;
+		}
+
+#ifndef NDEBUG
+		// The parent must not be part of the child's subtree
+		for (EntityId ancestor = parent; ancestor != NullID; ancestor = GetParent(ancestor))
+		{
+			assert(ancestor != child);
+		}
+#endif
+
+		DetachFromParent(child);
+
+		HierarchyNode& parentNode = GetWritableHierarchyNode(parent);
+		const EntityId previousLastChild = parentNode.lastChild;
+		const uint32_t parentDepth = parentNode.depth;
+
+		if (previousLastChild != NullID)
+		{
+			parentNode.lastChild = child;
+			GetWritableHierarchyNode(previousLastChild).nextSibling = child;
+		}
+		else
+		{
+			parentNode.firstChild = child;
+			parentNode.lastChild = child;
+		}
+
+		HierarchyNode& childNode = GetWritableHierarchyNode(child);
+		childNode.parent = parent;
+		childNode.previousSibling = previousLastChild;
+		childNode.nextSibling = NullID;
+
+		SetSubtreeDepth(child, parentDepth + 1);
+	}
 
 	void Registry::RemoveChild(EntityId parent, EntityId child)
 	{
-		assert(std::find(m_usedIds.begin(), m_usedIds.end(), parent) != m_usedIds.end());
-		assert(std::find(m_usedIds.begin(), m_usedIds.end(), child) != m_usedIds.end());
+		assert(IsValid(parent));
+		assert(IsValid(child));
 
-		auto& children = m_childEntities[parent];
-		if (auto it = std::find(children.begin(), children.end(), child); it != children.end())
+		if (GetParent(child) == parent)
 		{
-			children.erase(it);
+			DetachFromParent(child);
+			SetSubtreeDepth(child, 0);
 		}
 	}
 
-	const std::vector<EntityId>& Registry::GetChildren(EntityId parent) const
+	std::vector<EntityId> Registry::GetChildren(EntityId parent) const
+	{
+		std::vector<EntityId> children;
+		ForEachChild(parent, [&children](EntityId child) { children.emplace_back(child); });
+
+		return children;
+	}
+
+	EntityId Registry::GetParent(EntityId aId) const
+	{
+		const HierarchyNode* node = GetHierarchyNode(aId);
+		return node ? node->parent : NullID;
+	}
+
+	uint32_t Registry::GetDepth(EntityId aId) const
 	{
-		assert(m_childEntities.find(parent) != m_childEntities.end());
-		return m_childEntities.at(parent);
+		const HierarchyNode* node = GetHierarchyNode(aId);
+		return node ? node->depth : 0;
+	}
+
+	std::vector<EntityId> Registry::GetHierarchyOrder() const
+	{
+		std::vector<EntityId> order;
+
+		for (const EntityId id : GetAllEntities())
+		{
+			const HierarchyNode* node = GetHierarchyNode(id);
+			if (node && node->parent == NullID && node->firstChild != NullID)
+			{
+				TraverseHierarchy(id, [&order](EntityId entity) { order.emplace_back(entity); });
+			}
+		}
+
+		return order;
 	}
 
 	void Registry::RemoveEntity(EntityId aId)
 	{
-		assert(aId != 0);
-		assert(std::find(m_availiableIds.begin(), m_availiableIds.end(), aId) == m_availiableIds.end());
-		assert(std::find(m_usedIds.begin(), m_usedIds.end(), aId) != m_usedIds.end());
+		// Stale handles and ids removed with an ancestor are ignored
+		if (!IsValid(aId))
+		{
+			return;
+		}
+
+		const HierarchyNode* node = GetHierarchyNode(aId);
+		if (!node || (node->parent == NullID && node->firstChild == NullID))
+		{
+			DestroyEntity(aId);
+			return;
+		}
+
+		DetachFromParent(aId);
+
+		std::vector<EntityId> subtree;
+		TraverseHierarchy(aId, [&subtree](EntityId entity) { subtree.emplace_back(entity); });
+
+		for (const EntityId entity : subtree)
+		{
+			DestroyEntity(entity);
+		}
+	}
+
+	void Registry::RemoveEntities(std::span<const EntityId> aIds)
+	{
+		std::vector<EntityId> unlinked;
+		unlinked.reserve(aIds.size());
+
+		for (const EntityId id : aIds)
+		{
+			// Already removed together with an ancestor earlier in the list
+			if (!IsValid(id))
+			{
+				continue;
+			}
+
+			// Entities in a hierarchy take the cascading path
+			const HierarchyNode* node = GetHierarchyNode(id);
+			if (node && (node->parent != NullID || node->firstChild != NullID))
+			{
+				RemoveEntity(id);
+			}
+			else
+			{
+				unlinked.emplace_back(id);
+			}
+		}
+
+		for (auto& [guid, pool] : m_pools)
+		{
+			pool.RemoveComponents(unlinked);
+		}
+
+		for (const EntityId id : unlinked)
+		{
+			ReleaseEntitySlot(id);
+		}
+	}
+
+	void Registry::Playback(std::span<CommandBuffer> aBuffers)
+	{
+		size_t createCount = 0;
+		size_t commandCount = 0;
+		for (const CommandBuffer& buffer : aBuffers)
+		{
+			createCount += buffer.m_pendingEntityCount;
+			commandCount += buffer.m_commands.size();
+		}
 
-		auto it = std::find(m_usedIds.begin(), m_usedIds.end(), aId);
-		m_usedIds.erase(it);
+		struct ResolvedCommand
+		{
+			ComponentPool* pool;
+			EntityId entity;
+			size_t createdIndex; // Index into the created entities for commands on pending entities
+			const CommandBuffer::Command* command;
+			const uint8_t* data;
+		};
+
+		std::vector<ResolvedCommand> resolved;
+		resolved.reserve(commandCount);
+
+		ComponentPool* lastPool = nullptr;
+		WireGUID lastGuid;
+
+		// Every command is resolved and checked before the pending entities are created, so a rejected playback leaves the entities and components as they were
+		size_t createdOffset = 0;
+		for (CommandBuffer& buffer : aBuffers)
+		{
+			for (const CommandBuffer::Command& command : buffer.m_commands)
+			{
+				const bool pending = command.pendingIndex != CommandBuffer::NullIndex;
+				if (!pending && !IsValid(command.entity))
+				{
+					continue;
+				}
+
+				ResolvedCommand& resolvedCommand = resolved.emplace_back(ResolvedCommand{ nullptr, command.entity, SIZE_MAX, &command, buffer.m_data.data() + command.dataOffset });
+				if (pending)
+				{
+					resolvedCommand.createdIndex = createdOffset + command.pendingIndex;
+				}
+
+				if (command.type == CommandBuffer::CommandType::Destroy)
+				{
+					continue;
+				}
+
+				// Commands for the same pool tend to be recorded together
+				if (!lastPool || !(lastGuid == command.guid))
+				{
+					auto it = m_pools.find(command.guid);
+					if (it != m_pools.end())
+					{
+						lastPool = &it->second;
+					}
+					else if (command.type == CommandBuffer::CommandType::Add)
+					{
+						lastPool = &CreatePool(command.guid, command.dataSize);
+					}
+					else
+					{
+						lastPool = nullptr;
+						resolved.pop_back();
+						continue;
+					}
+
+					lastGuid = command.guid;
+				}
+
+				// CommandBuffer already refuses registered types with ops, pools created with ops elsewhere are caught here
+				if (command.type != CommandBuffer::CommandType::Remove)
+				{
+					lastPool->CheckTriviallyCopyable();
+					lastPool->CheckComponentSize(command.dataSize);
+				}
+
+				resolvedCommand.pool = lastPool;
+			}
+
+			createdOffset += buffer.m_pendingEntityCount;
+		}
+
+		std::vector<EntityId> created(createCount);
+		CreateEntities(createCount, created);
+
+		createdOffset = 0;
+		for (CommandBuffer& buffer : aBuffers)
+		{
+			buffer.m_createdEntities.assign(created.begin() + createdOffset, created.begin() + createdOffset + buffer.m_pendingEntityCount);
+			createdOffset += buffer.m_pendingEntityCount;
+		}
+
+		// Destroys are applied after all component commands
+		std::vector<EntityId> destroyed;
+		for (ResolvedCommand& resolvedCommand : resolved)
+		{
+			if (resolvedCommand.createdIndex != SIZE_MAX)
+			{
+				resolvedCommand.entity = created[resolvedCommand.createdIndex];
+			}
+
+			if (resolvedCommand.command->type == CommandBuffer::CommandType::Destroy)
+			{
+				destroyed.emplace_back(resolvedCommand.entity);
+			}
+		}
+
+		std::erase_if(resolved, [](const ResolvedCommand& resolvedCommand) { return resolvedCommand.command->type == CommandBuffer::CommandType::Destroy; });
+
+		std::stable_sort(resolved.begin(), resolved.end(), [](const ResolvedCommand& lhs, const ResolvedCommand& rhs) { return std::less<ComponentPool*>()(lhs.pool, rhs.pool); });
+
+		for (const ResolvedCommand& resolvedCommand : resolved)
+		{
+			ComponentPool& pool = *resolvedCommand.pool;
+			const CommandBuffer::Command& command = *resolvedCommand.command;
+			const std::span<const uint8_t> data(resolvedCommand.data, command.dataSize);
+
+			switch (command.type)
+			{
+				case CommandBuffer::CommandType::Add:
+				{
+					if (pool.HasComponent(resolvedCommand.entity))
+					{
+						pool.SetComponentData(data, resolvedCommand.entity);
+					}
+					else
+					{
+						pool.AddComponent(resolvedCommand.entity, data);
+					}
+					break;
+				}
+
+				case CommandBuffer::CommandType::Remove:
+				{
+					if (pool.HasComponent(resolvedCommand.entity))
+					{
+						pool.RemoveComponent(resolvedCommand.entity);
+					}
+					break;
+				}
+
+				case CommandBuffer::CommandType::Set:
+				{
+					if (pool.HasComponent(resolvedCommand.entity))
+					{
+						pool.SetComponentData(data, resolvedCommand.entity);
+					}
+					break;
+				}
+
+				// Destroys were collected after resolving
+				case CommandBuffer::CommandType::Destroy:
+					break;
+			}
+		}
+
+		std::sort(destroyed.begin(), destroyed.end());
+		destroyed.erase(std::unique(destroyed.begin(), destroyed.end()), destroyed.end());
+		RemoveEntities(destroyed);
+
+		for (CommandBuffer& buffer : aBuffers)
+		{
+			buffer.Clear();
+		}
+	}
+
+	void Registry::Playback(CommandBuffer& aBuffer)
+	{
+		Playback(std::span<CommandBuffer>(&aBuffer, 1));
+	}
+
+	void Registry::CopyGroups(const Registry& aRegistry)
+	{
+		for (const OwningGroup& group : aRegistry.m_groups)
+		{
+			m_groups.emplace_back(group, GetPoolCopies(aRegistry, group.GetPools()));
+		}
+	}
+
+	void Registry::CopyQueries(const Registry& aRegistry)
+	{
+		for (const QueryCache& query : aRegistry.m_queries)
+		{
+			m_queries.emplace_back(query, GetPoolCopies(aRegistry, query.GetPools()));
+		}
+	}
+
+	std::vector<ComponentPool*> Registry::GetPoolCopies(const Registry& aRegistry, std::span<ComponentPool* const> aPools)
+	{
+		std::vector<ComponentPool*> pools;
+		for (const ComponentPool* sourcePool : aPools)
+		{
+			auto it = std::find_if(aRegistry.m_pools.begin(), aRegistry.m_pools.end(), [sourcePool](const auto& entry) { return &entry.second == sourcePool; });
+			pools.emplace_back(&m_pools.at(it->first));
+		}
+
+		return pools;
+	}
 
+	QueryCache& Registry::GetOrCreateQueryCache(std::span<ComponentPool* const> aPools)
+	{
+		std::vector<ComponentPool*> sortedPools(aPools.begin(), aPools.end());
+		std::sort(sortedPools.begin(), sortedPools.end());
+
+		for (QueryCache& query : m_queries)
+		{
+			std::vector<ComponentPool*> queryPools(query.GetPools().begin(), query.GetPools().end());
+			std::sort(queryPools.begin(), queryPools.end());
+
+			if (queryPools == sortedPools)
+			{
+				return query;
+			}
+		}
+
+		return m_queries.emplace_back(aPools);
+	}
+
+	const Registry::HierarchyNode* Registry::GetHierarchyNode(EntityId aId) const
+	{
+		const uint32_t index = Entity::GetIndex(aId);
+		return index < m_hierarchy.GetSize() ? &m_hierarchy[index] : nullptr;
+	}
+
+	Registry::HierarchyNode& Registry::GetWritableHierarchyNode(EntityId aId)
+	{
+		const uint32_t index = Entity::GetIndex(aId);
+		if (index >= m_hierarchy.GetSize())
+		{
+			m_hierarchy.Resize(std::max((size_t)index + 1, m_entitySlots.GetSize()));
+		}
+
+		return m_hierarchy.GetWritable(index);
+	}
+
+	void Registry::DetachFromParent(EntityId aId)
+	{
+		const HierarchyNode* node = GetHierarchyNode(aId);
+		if (!node || node->parent == NullID)
+		{
+			return;
+		}
+
+		const EntityId parent = node->parent;
+		const EntityId previous = node->previousSibling;
+		const EntityId next = node->nextSibling;
+
+		HierarchyNode& parentNode = GetWritableHierarchyNode(parent);
+		if (parentNode.firstChild == aId)
+		{
+			parentNode.firstChild = next;
+		}
+
+		if (parentNode.lastChild == aId)
+		{
+			parentNode.lastChild = previous;
+		}
+
+		if (previous != NullID)
+		{
+			GetWritableHierarchyNode(previous).nextSibling = next;
+		}
+
+		if (next != NullID)
+		{
+			GetWritableHierarchyNode(next).previousSibling = previous;
+		}
+
+		HierarchyNode& childNode = GetWritableHierarchyNode(aId);
+		childNode.parent = NullID;
+		childNode.previousSibling = NullID;
+		childNode.nextSibling = NullID;
+	}
+
+	void Registry::SetSubtreeDepth(EntityId aRoot, uint32_t aDepth)
+	{
+		const uint32_t offset = aDepth - GetDepth(aRoot);
+		if (offset == 0)
+		{
+			return;
+		}
+
+		TraverseHierarchy(aRoot, [this, offset](EntityId entity)
+			{
+				m_hierarchy.GetWritable(Entity::GetIndex(entity)).depth += offset;
+			});
+	}
+
+	void Registry::DestroyEntity(EntityId aId)
+	{
 		for (auto& compPool : m_pools)
 		{
 			if (compPool.second.HasComponent(aId))
@@ -97,79 +678,261 @@ namespace Wire
 			}
 		}
 
-		m_availiableIds.emplace_back(aId);
+		// Entities outside the hierarchy leave their node untouched, so their pages stay shared
+		const HierarchyNode* node = GetHierarchyNode(aId);
+		if (node && (node->parent != NullID || node->firstChild != NullID || node->depth != 0))
+		{
+			m_hierarchy.GetWritable(Entity::GetIndex(aId)) = HierarchyNode{};
+		}
+
+		ReleaseEntitySlot(aId);
+	}
+
+	void Registry::ReleaseEntitySlot(EntityId aId)
+	{
+		WIRE_STATS(m_counters.destroys.Add());
+		EntityList& usedIds = GetWritableUsedIds();
+		EntitySlot& slot = m_entitySlots.GetWritable(Entity::GetIndex(aId));
+
+		// Swap the last used id into the freed position
+		const EntityId lastId = usedIds.back();
+		usedIds[slot.usedIndex] = lastId;
+		m_entitySlots.GetWritable(Entity::GetIndex(lastId)).usedIndex = slot.usedIndex;
+		usedIds.pop_back();
+
+		slot.usedIndex = NullIndex;
+		slot.version = (slot.version + 1) & Entity::VersionMask;
+		m_availiableSlots.EmplaceBack() = Entity::GetIndex(aId);
+	}
+
+	Registry::EntityList& Registry::GetWritableUsedIds()
+	{
+		if (!m_usedIds)
+		{
+			m_usedIds = std::allocate_shared<EntityList>(std::pmr::polymorphic_allocator<EntityList>(GetMemoryResource()));
+		}
+		else if (m_usedIds.use_count() > 1)
+		{
+			m_usedIds = std::allocate_shared<EntityList>(std::pmr::polymorphic_allocator<EntityList>(GetMemoryResource()), *m_usedIds);
+		}
+
+		return *m_usedIds;
 	}
 
 	void Registry::Clear()
 	{
+		ClearComponents();
+		m_hierarchy.Clear();
+		m_usedIds = nullptr;
+
+		// A moved-from registry has no slots left, slot zero stays reserved for the null ID
+		if (m_entitySlots.IsEmpty())
+		{
+			m_entitySlots.EmplaceBack();
+		}
+
+		// The slots are kept and live ones get a new version, so handles from before the clear stay invalid once their slot is reused
+		m_availiableSlots.Clear();
+		m_availiableSlots.Resize(m_entitySlots.GetSize() - 1);
+
+		for (size_t index = 1; index < m_entitySlots.GetSize(); index++)
+		{
+			if (m_entitySlots[index].usedIndex != NullIndex)
+			{
+				EntitySlot& slot = m_entitySlots.GetWritable(index);
+				slot.usedIndex = NullIndex;
+				slot.version = (slot.version + 1) & Entity::VersionMask;
+			}
+
+			// Reused lowest index first
+			m_availiableSlots.GetWritable(m_entitySlots.GetSize() - 1 - index) = (uint32_t)index;
+		}
+	}
+
+	void Registry::ClearComponents()
+	{
+		// Groups and queries point into the pools
+		m_groups.clear();
+		m_queries.clear();
 		m_pools.clear();
-		m_availiableIds.clear();
-		m_usedIds.clear();
-		m_nextEntityId = 1;
+		m_typedPools.clear();
 	}
 
-	void Registry::AddComponent(const std::vector<uint8_t> data, const WireGUID& guid, EntityId aId)
+	void Registry::AddComponent(std::span<const uint8_t> data, const WireGUID& guid, EntityId aId)
 	{
 		auto it = m_pools.find(guid);
-		if (it != m_pools.end())
+		ComponentPool& pool = (it != m_pools.end()) ? it->second : CreatePool(guid, (uint32_t)data.size());
+
+		pool.CheckTriviallyCopyable();
+		pool.AddComponent(aId, data);
+	}
+
+	void Registry::AddComponents(std::span<const EntityId> aIds, std::span<const uint8_t> data, const WireGUID& guid, uint32_t aComponentSize)
+	{
+		auto it = m_pools.find(guid);
+		ComponentPool& pool = (it != m_pools.end()) ? it->second : CreatePool(guid, aComponentSize);
+
+		assert(pool.GetComponentSize() == aComponentSize);
+		pool.CheckTriviallyCopyable();
+		pool.AddComponents(aIds, data);
+	}
+
+	void Registry::RemoveComponent(const WireGUID& guid, EntityId id)
+	{
+		auto it = m_pools.find(guid);
+		assert(it != m_pools.end());
+
+		it->second.RemoveComponent(id);
+	}
+
+	bool Registry::HasComponent(const WireGUID& guid, EntityId id) const
+	{
+		auto it = m_pools.find(guid);
+		return it != m_pools.end() && it->second.HasComponent(id);
+	}
+
+	std::span<uint8_t> Registry::GetComponentBytes(const WireGUID& guid, EntityId id)
+	{
+		auto it = m_pools.find(guid);
+		assert(it != m_pools.end());
+
+		return it->second.GetComponentBytes(id);
+	}
+
+	Registry::Property Registry::FindProperty(const WireGUID& guid, uint64_t aNameHash) const
+	{
+		const ComponentRegistry::RegistrationInfo& info = ComponentRegistry::GetRegistryDataFromGUID(guid);
+		const ComponentRegistry::ComponentProperty* property = ComponentRegistry::FindProperty(info, aNameHash);
+		if (!info.hasLayout || !property)
 		{
-			it->second.AddComponent(aId, data);
+			throw std::logic_error("The property does not exist or the component layout is unknown");
 		}
-		else
+
+		return Property{ guid, (uint32_t)property->offset, (uint32_t)property->size };
+	}
+
+	void Registry::CheckPropertySize(const Property& aProperty, size_t aSize)
+	{
+		if (aProperty.size != aSize)
 		{
-			m_pools.emplace(guid, ComponentPool((uint32_t)data.size()));
-			m_pools[guid].AddComponent(aId, data);
+			throw std::logic_error("The value type does not match the size of the property");
 		}
 	}
 
+	std::span<const uint8_t> Registry::GetPropertyBytes(EntityId aEntity, const Property& aProperty) const
+	{
+		auto it = m_pools.find(aProperty.guid);
+		assert(it != m_pools.end());
+
+		return it->second.GetPropertyBytes(aEntity, aProperty.offset, aProperty.size);
+	}
+
+	std::span<uint8_t> Registry::GetPropertyBytes(EntityId aEntity, const Property& aProperty)
+	{
+		auto it = m_pools.find(aProperty.guid);
+		assert(it != m_pools.end());
+
+		return it->second.GetPropertyBytes(aEntity, aProperty.offset, aProperty.size);
+	}
+
+	void Registry::SetComponentData(std::span<const uint8_t> data, const WireGUID& guid, EntityId id)
+	{
+		auto it = m_pools.find(guid);
+		assert(it != m_pools.end());
+
+		it->second.CheckTriviallyCopyable();
+		it->second.SetComponentData(data, id);
+	}
+
 	std::vector<uint8_t> Registry::GetEntityComponentData(EntityId id) const
 	{
-		std::vector<uint8_t> data;
+		std::vector<uint8_t> data(GetEntityComponentDataSize(id));
+		GetEntityComponentData(id, data);
+
+		return data;
+	}
+
+	size_t Registry::GetEntityComponentData(EntityId id, std::span<uint8_t> outData) const
+	{
+		size_t size = 0;
 
 		for (const auto& pool : m_pools)
 		{
 			if (pool.second.HasComponent(id))
 			{
-				const size_t size = data.size();
 				const uint32_t componentSize = pool.second.GetComponentSize();
+				assert(size + componentSize <= outData.size());
 
-				data.resize(data.size() + componentSize);
+				pool.second.CopyComponentData(id, outData.subspan(size, componentSize));
+				size += componentSize;
+			}
+		}
 
-				std::vector<uint8_t> componentData = pool.second.GetComponentData(id);
-				memcpy_s(&data[size], componentSize, componentData.data(), componentSize);
+		return size;
+	}
+
+	size_t Registry::GetEntityComponentDataSize(EntityId id) const
+	{
+		size_t size = 0;
+
+		for (const auto& pool : m_pools)
+		{
+			if (pool.second.HasComponent(id))
+			{
+				size += pool.second.GetComponentSize();
 			}
 		}
 
-		return data;
+		return size;
 	}
+
 	std::vector<uint8_t> Registry::GetEntityComponentDataEncoded(EntityId id) const
 	{
-		std::vector<uint8_t> data;
+		std::vector<uint8_t> data(GetEntityComponentDataEncodedSize(id));
+		GetEntityComponentDataEncoded(id, data);
+
+		return data;
+	}
+
+	size_t Registry::GetEntityComponentDataEncoded(EntityId id, std::span<uint8_t> outData) const
+	{
+		size_t size = 0;
 
 		for (const auto& pool : m_pools)
 		{
 			if (pool.second.HasComponent(id))
 			{
-				const std::string componentName = ComponentRegistry::GetNameFromGUID(pool.first);
-				const uint16_t nameSize = (uint16_t)componentName.size();
-
-				size_t size = data.size();
+				const uint16_t tag = Serializer::GUIDEncodingTag;
 				const uint32_t componentSize = pool.second.GetComponentSize();
+				assert(size + sizeof(uint16_t) + sizeof(WireGUID) + componentSize <= outData.size());
 
-				data.resize(data.size() + sizeof(uint16_t) + nameSize + componentSize);
+				memcpy(&outData[size], &tag, sizeof(uint16_t));
+				size += sizeof(uint16_t);
 
-				std::vector<uint8_t> componentData = pool.second.GetComponentData(id);
+				memcpy(&outData[size], &pool.first, sizeof(WireGUID));
+				size += sizeof(WireGUID);
 
-				memcpy_s(&data[size], sizeof(uint16_t), &nameSize, sizeof(uint16_t));
-				size += sizeof(uint16_t);
+				pool.second.CopyComponentData(id, outData.subspan(size, componentSize));
+				size += componentSize;
+			}
+		}
+
+		return size;
+	}
 
-				memcpy_s(&data[size], nameSize, componentName.data(), nameSize);
-				size += nameSize;
+	size_t Registry::GetEntityComponentDataEncodedSize(EntityId id) const
+	{
+		size_t size = 0;
 
-				memcpy_s(&data[size], componentSize, componentData.data(), componentSize);
+		for (const auto& pool : m_pools)
+		{
+			if (pool.second.HasComponent(id))
+			{
+				size += sizeof(uint16_t) + sizeof(WireGUID) + pool.second.GetComponentSize();
 			}
 		}
-		return data;
+
+		return size;
 	}
 
 	const uint32_t Registry::GetComponentCount(EntityId aId) const
@@ -185,4 +948,102 @@ namespace Wire
 		}
 		return count;
 	}
-}
+
+	RegistryStats Registry::GetStats() const
+	{
+		RegistryStats stats;
+		stats.entityCount = GetAllEntities().size();
+		stats.entitySlotCount = m_entitySlots.GetSize() - 1;
+		stats.freeSlotCount = m_availiableSlots.GetSize();
+
+		stats.bytesReserved = SlotsPerPage * (m_entitySlots.GetPageCount() * sizeof(EntitySlot) + m_availiableSlots.GetPageCount() * sizeof(uint32_t) +
+			m_hierarchy.GetPageCount() * sizeof(HierarchyNode)) + (m_usedIds ? m_usedIds->capacity() * sizeof(EntityId) : 0);
+		stats.bytesUsed = m_entitySlots.GetSize() * sizeof(EntitySlot) + m_availiableSlots.GetSize() * sizeof(uint32_t) +
+			GetAllEntities().size() * sizeof(EntityId) + m_hierarchy.GetSize() * sizeof(HierarchyNode);
+
+		for (const auto& [guid, pool] : m_pools)
+		{
+			PoolStats& poolStats = stats.pools.emplace_back(pool.GetStats());
+			poolStats.guid = guid;
+
+			stats.bytesReserved += poolStats.bytesReserved;
+			stats.bytesUsed += poolStats.bytesUsed;
+		}
+
+#ifdef WIRE_ENABLE_STATS
+		stats.createCount = m_counters.creates.Get();
+		stats.destroyCount = m_counters.destroys.Get();
+		stats.forEachCount = m_counters.forEachCalls.Get();
+		stats.forEachMilliseconds = (double)m_counters.forEachNanoseconds.Get() / 1e6;
+#endif
+
+		return stats;
+	}
+
+	ComponentPool* Registry::CachePool(uint32_t aTypeIndex, const WireGUID& guid)
+	{
+		auto it = m_pools.find(guid);
+		if (it == m_pools.end())
+		{
+			return nullptr;
+		}
+
+		if (aTypeIndex >= m_typedPools.size())
+		{
+			m_typedPools.resize(aTypeIndex + 1, nullptr);
+		}
+
+		ComponentPool* pool = &it->second;
+		m_typedPools[aTypeIndex] = pool;
+
+		return pool;
+	}
+
+	void Registry::EnableColumnLayout(const WireGUID& guid)
+	{
+		const ComponentRegistry::RegistrationInfo& info = ComponentRegistry::GetRegistryDataFromGUID(guid);
+		assert(info.hasLayout && !info.ops && "Column layouts need trivially copyable components with a parsed definition");
+
+		auto it = m_pools.find(guid);
+		ComponentPool& pool = (it != m_pools.end()) ? it->second : CreatePool(guid, (uint32_t)info.size);
+		assert(!pool.GetGroup() && "Grouped pools can not use a column layout");
+
+		std::vector<ComponentPool::Column> columns;
+		for (const ComponentRegistry::ComponentProperty& property : info.properties)
+		{
+			columns.emplace_back(ComponentPool::Column{ (uint32_t)property.offset, (uint32_t)ComponentRegistry::GetSizeFromType(property.type) });
+		}
+
+		pool.SetColumnLayout(columns);
+	}
+
+	size_t Registry::GetColumnIndex(const WireGUID& guid, const std::string& aPropertyName) const
+	{
+		// Columns are created in property order
+		const ComponentRegistry::RegistrationInfo& info = ComponentRegistry::GetRegistryDataFromGUID(guid);
+		for (size_t i = 0; i < info.properties.size(); i++)
+		{
+			if (info.properties[i].name == aPropertyName)
+			{
+				return i;
+			}
+		}
+
+		return ~size_t(0);
+	}
+
+	ComponentPool& Registry::CreatePool(const WireGUID& guid, uint32_t aComponentSize, const ComponentOps* aOps, uint32_t aAlignment)
+	{
+		if (!aOps || aAlignment == 0)
+		{
+			const ComponentRegistry::RegistrationInfo& info = ComponentRegistry::GetRegistryDataFromGUID(guid);
+			aOps = aOps ? aOps : info.ops;
+			aAlignment = aAlignment ? aAlignment : (uint32_t)info.alignment;
+		}
+
+		ComponentPool& pool = m_pools.try_emplace(guid, aComponentSize, aOps, aAlignment, GetMemoryResource()).first->second;
+		pool.SetCurrentTick(m_currentTick);
+
+		return pool;
+	}
+}
\ No newline at end of file
@@ -3,43 +3,124 @@
 #include "Entity.h"
 #include "WireGUID.h"
 #include "ComponentPool.hpp"
+#include "View.h"
+#include "TypeIndex.h"
+#include "CommandBuffer.h"
+#include "OwningGroup.h"
+#include "Query.h"
+#include "ComponentColumn.h"
+#include "PagedArray.h"
+
+#include <unordered_map>
+#include <list>
+#include <memory_resource>
 
 namespace Wire
 {
-	// TODO: Serialization
-
 	class Registry
 	{
 	public:
-		Registry() = default;
+		Registry();
+
+		// Pools, entity bookkeeping and the hierarchy are allocated from aResource, it has to outlive the registry and its clones
+		explicit Registry(std::pmr::memory_resource* aResource);
+
 		Registry(const Registry& registry);
+
+		// Takes over the storage, including its memory resource
+		Registry(Registry&& registry) = default;
 		~Registry();
 
+		Registry& operator=(const Registry& registry);
+
+		// Takes over the storage if both registries use equal memory resources, otherwise copies it into this registry's resource
+		Registry& operator=(Registry&& registry);
+
+		/*
+		* Returns a copy that shares the component pages, the entity slot and hierarchy pages and the entity list with
+		* this registry. Pages are copied the first time either registry writes to them, so cloning costs the page tables.
+		* The entity list is contiguous for GetAllEntities, it is copied as a whole on the first create or destroy after cloning.
+		*/
+		Registry Clone() const;
+
 		EntityId CreateEntity();
+
+		// Adds an entity with a known id, returns NullID if the id is null or its slot is already in use
 		EntityId AddEntity(EntityId aId);
 
+		// Creates aCount entities into the start of outIds, reusing freed slots first
+		void CreateEntities(size_t aCount, std::span<EntityId> outIds);
+
+		// Returns false for null handles and handles to destroyed entities
+		bool IsValid(EntityId aId) const;
+
+		/*
+		* Hierarchy: every entity slot stores its parent, first and last child, siblings and depth.
+		* Attaching or detaching a leaf is O(1), moving a subtree updates the depth of its entities.
+		*/
 		void AddChild(EntityId parent, EntityId child);
 		void RemoveChild(EntityId parent, EntityId child);
 
-		const std::vector<EntityId>& GetChildren(EntityId parent) const;
+		std::vector<EntityId> GetChildren(EntityId parent) const;
+		EntityId GetParent(EntityId aId) const;
+		uint32_t GetDepth(EntityId aId) const;
+
+		// Calls func(child) for every direct child in the order they were added
+		template<typename F>
+		void ForEachChild(EntityId parent, F&& func) const;
 
+		// Visits aRoot and its descendants depth first, every entity is visited after its parent
+		template<typename F>
+		void TraverseHierarchy(EntityId aRoot, F&& func) const;
+
+		// Every entity in the hierarchy, depth first from each root, suitable for a single linear transform propagation pass
+		std::vector<EntityId> GetHierarchyOrder() const;
+
+		// Also destroys every descendant of the entity, invalid ids are ignored
 		void RemoveEntity(EntityId aId);
+
+		// Removes the components pool by pool instead of entity by entity, the ids must be unique
+		void RemoveEntities(std::span<const EntityId> aIds);
+
+		// Removes every entity and component. The entity slots are kept with new versions, so no handle from before the clear becomes valid again
 		void Clear();
 
-		void AddComponent(const std::vector<uint8_t> data, const WireGUID& guid, EntityId id);
+		// The raw byte versions throw std::logic_error for components with ComponentOps or data that is not one component
+		void AddComponent(std::span<const uint8_t> data, const WireGUID& guid, EntityId id);
+		void AddComponents(std::span<const EntityId> aIds, std::span<const uint8_t> data, const WireGUID& guid, uint32_t aComponentSize);
+		void RemoveComponent(const WireGUID& guid, EntityId id);
+		bool HasComponent(const WireGUID& guid, EntityId id) const;
+		std::span<uint8_t> GetComponentBytes(const WireGUID& guid, EntityId id);
+		void SetComponentData(std::span<const uint8_t> data, const WireGUID& guid, EntityId id);
 		std::vector<uint8_t> GetEntityComponentData(EntityId id) const;
 
+		// Writes into outData, which must hold GetEntityComponentDataSize bytes, returns the bytes written
+		size_t GetEntityComponentData(EntityId id, std::span<uint8_t> outData) const;
+		size_t GetEntityComponentDataSize(EntityId id) const;
+
 		/*
-		* First 2 bytes: The length of the name
-		* Next X bytes: The name of the component
+		* First 2 bytes: Serializer::GUIDEncodingTag
+		* Next 16 bytes: The GUID of the component
 		* Next X bytes: The data of the component
 		*/
 		std::vector<uint8_t> GetEntityComponentDataEncoded(EntityId id) const;
+
+		// Writes into outData, which must hold GetEntityComponentDataEncodedSize bytes, returns the bytes written
+		size_t GetEntityComponentDataEncoded(EntityId id, std::span<uint8_t> outData) const;
+		size_t GetEntityComponentDataEncodedSize(EntityId id) const;
 		const uint32_t GetComponentCount(EntityId aId) const;
 
 		template<typename T, typename ... Args>
 		T& AddComponent(EntityId aEntity, Args&&... args);
 
+		// Bulk versions, the pool grows once and the components are written contiguously
+		template<typename T>
+		void AddComponents(std::span<const EntityId> aEntities, const T& aPrototype);
+
+		template<typename T>
+		void AddComponents(std::span<const EntityId> aEntities, std::span<const T> aComponents);
+
+		// Mutable access marks the component as changed when its pool tracks changes
 		template<typename T>
 		T& GetComponent(EntityId aEntity);
 
@@ -52,61 +133,322 @@ namespace Wire
 		template<typename T>
 		void RemoveComponent(EntityId aEntity);
 
+		// Copies every component of type T in pool order
 		template<typename T>
-		const std::vector<T>& GetAllComponents() const;
+		std::vector<T> GetAllComponents() const;
+
+		/*
+		* Reflective access to a single property through the offsets computed at registration, reads and writes
+		* the pool memory in place without allocating. Hash the name once with ComponentRegistry::HashPropertyName,
+		* or resolve it once with FindProperty to skip the registry lookup on every access.
+		* Mutable access marks the component as changed when its pool tracks changes.
+		* Unknown properties and value types whose size does not match the property throw std::logic_error.
+		*/
+		struct Property
+		{
+			WireGUID guid = WireGUID::Null();
+			uint32_t offset = 0;
+			uint32_t size = 0;
+		};
+
+		Property FindProperty(const WireGUID& guid, uint64_t aNameHash) const;
+
+		std::span<const uint8_t> GetPropertyBytes(EntityId aEntity, const Property& aProperty) const;
+		std::span<uint8_t> GetPropertyBytes(EntityId aEntity, const Property& aProperty);
+
+		template<typename P>
+		const P& GetProperty(EntityId aEntity, const Property& aProperty) const;
+
+		template<typename P>
+		const P& GetProperty(EntityId aEntity, const WireGUID& guid, uint64_t aNameHash) const;
+
+		template<typename P>
+		void SetProperty(EntityId aEntity, const Property& aProperty, const P& value);
+
+		template<typename P>
+		void SetProperty(EntityId aEntity, const WireGUID& guid, uint64_t aNameHash, const P& value);
 
 		std::unordered_map<WireGUID, std::vector<uint8_t>> GetComponents(EntityId aEntity) const;
 		void SetComponents(const std::unordered_map<WireGUID, std::vector<uint8_t>>& components, EntityId aEntity);
 
+		// The entities with a component of type T in dense order, valid until a T is added or removed
+		template<typename T>
+		std::span<const EntityId> GetComponentView() const;
+
+		inline std::span<const EntityId> GetAllEntities() const { return m_usedIds ? std::span<const EntityId>(*m_usedIds) : std::span<const EntityId>(); }
+
+		// Calls func(id) for every entity in a slot page not shared with aClone, these are the only ones that can have been created or destroyed since cloning
+		template<typename F>
+		void ForEachUnsharedEntity(const Registry& aClone, F&& func) const;
+		inline const std::pmr::unordered_map<WireGUID, ComponentPool>& GetPools() const { return m_pools; }
+		inline std::pmr::memory_resource* GetMemoryResource() const { return m_entitySlots.GetMemoryResource(); }
+
+		/*
+		* Change tracking: components are stamped with the current tick when added or mutably accessed.
+		* Tracking is enabled per component type, views over const types do not mark components as changed.
+		*/
+		inline const uint64_t GetCurrentTick() const { return m_currentTick; }
+		uint64_t AdvanceTick();
+
+		template<typename T>
+		void EnableChangeTracking();
+
+		template<typename T>
+		void MarkChanged(EntityId aEntity);
+
+		// Visits the components of type T changed at or after aSinceTick
+		template<typename T, typename F>
+		void ForEachChanged(uint64_t aSinceTick, F&& func);
+
+		/*
+		* Makes the pools of T keep the entities that have all of T packed at the front in the same order.
+		* Views and ForEach over exactly these types then walk the pools linearly without lookups.
+		* A pool can only be owned by one group, grouping an owned pool again throws std::logic_error.
+		* Adding and removing grouped components costs a swap per pool.
+		*/
+		template<typename ... T>
+		void CreateGroup();
+
+		/*
+		* Switches the pool of T to a column layout with one column per registered property, so systems can
+		* stream a single property with GetColumn. T must be trivially copyable with a fully parsed definition.
+		* Typed references to T are not available afterwards: AddComponent<T>, GetComponent, views, queries and
+		* ForEachChanged throw std::logic_error. Add the components with AddComponents and copy them out with GetAllComponents.
+		*/
 		template<typename T>
-		const std::vector<EntityId> GetComponentView() const;
+		void EnableColumnLayout();
+		void EnableColumnLayout(const WireGUID& guid);
+
+		// The index of the column holding the named property, or ~0 if it does not exist
+		size_t GetColumnIndex(const WireGUID& guid, const std::string& aPropertyName) const;
+
+		template<typename P>
+		ComponentColumn<P> GetColumn(const WireGUID& guid, const std::string& aPropertyName);
+
+		template<typename ... T>
+		View<T...> GetView();
+
+		/*
+		* Returns a query over the entities that have every component in T. Its entities are cached and kept up to date
+		* as components are added and removed, so iterating it costs no matching. Queries over the same types in any
+		* order share one cache, which lives as long as the registry. Handles are invalidated by Clear and by assigning to the registry.
+		*/
+		template<typename ... T>
+		Query<T...> GetQuery();
+
+		/*
+		* Entity and per pool memory, occupancy and, when built with WIRE_ENABLE_STATS, operation counts and ForEach timings.
+		* Pass the result to Trace::RecordStats to add it to a trace.
+		*/
+		RegistryStats GetStats() const;
 
 		template<typename ... T, typename F>
 		void ForEach(F&& func);
 
+		// Runs func over the matching entities on multiple threads, func must not add or remove entities or components
+		template<typename ... T, typename F>
+		void ParallelForEach(F&& func, JobSystem& jobSystem = JobSystem::GetDefault(), size_t aChunkSize = 1024);
+
+		/*
+		* Applies the recorded commands and clears the buffers. Entities are created first, component commands are
+		* then grouped by pool keeping their recorded order within a pool, destroys run last.
+		* Commands targeting entities that are no longer valid are skipped.
+		*/
+		void Playback(std::span<CommandBuffer> aBuffers);
+		void Playback(CommandBuffer& aBuffer);
+
 	private:
-		std::unordered_map<WireGUID, ComponentPool> m_pools;
-		std::unordered_map<EntityId, std::vector<EntityId>> m_childEntities;
+		// The const lookup never writes the type cache, so any number of threads can read the registry at once
+		template<typename T>
+		const ComponentPool* GetPool() const;
+
+		template<typename T>
+		ComponentPool* GetPool();
+
+		template<typename T>
+		ComponentPool& GetOrCreatePool();
+
+		ComponentPool* CachePool(uint32_t aTypeIndex, const WireGUID& guid);
+		// Without ops and alignment the pool uses the ones the GUID was registered with, if any
+		ComponentPool& CreatePool(const WireGUID& guid, uint32_t aComponentSize, const ComponentOps* aOps = nullptr, uint32_t aAlignment = 0);
+
+		static void CheckPropertySize(const Property& aProperty, size_t aSize);
+
+		std::pmr::unordered_map<WireGUID, ComponentPool> m_pools;
+
+		struct HierarchyNode
+		{
+			EntityId parent = NullID;
+			EntityId firstChild = NullID;
+			EntityId lastChild = NullID;
+			EntityId previousSibling = NullID;
+			EntityId nextSibling = NullID;
+			uint32_t depth = 0;
+		};
+
+		const HierarchyNode* GetHierarchyNode(EntityId aId) const;
+		HierarchyNode& GetWritableHierarchyNode(EntityId aId);
+
+		void DetachFromParent(EntityId aId);
+		void SetSubtreeDepth(EntityId aRoot, uint32_t aDepth);
+		void DestroyEntity(EntityId aId);
+		void ReleaseEntitySlot(EntityId aId);
+
+		// Drops the groups, queries and pools but leaves the entities alone
+		void ClearComponents();
+
+		// Recreates the groups and queries of aRegistry over this registry's copies of its pools
+		void CopyGroups(const Registry& aRegistry);
+		void CopyQueries(const Registry& aRegistry);
+		std::vector<ComponentPool*> GetPoolCopies(const Registry& aRegistry, std::span<ComponentPool* const> aPools);
+
+		QueryCache& GetOrCreateQueryCache(std::span<ComponentPool* const> aPools);
+
+		// Indexed by TypeIndex, filled by the non-const lookups from m_pools which keeps its element addresses stable
+		std::pmr::vector<ComponentPool*> m_typedPools;
+
+		uint64_t m_currentTick = 1;
 
-		EntityId m_nextEntityId = 1; // ID zero is null
-		std::vector<EntityId> m_availiableIds;
-		std::vector<EntityId> m_usedIds;
+		struct EntitySlot
+		{
+			uint32_t version = 0;
+			uint32_t usedIndex = NullIndex; // Index into m_usedIds, NullIndex if the slot is free
+		};
+
+		static constexpr uint32_t NullIndex = std::numeric_limits<uint32_t>::max();
+
+		using EntityList = std::pmr::vector<EntityId>;
+		static constexpr size_t SlotsPerPage = 4096;
+
+		EntityList& GetWritableUsedIds();
+
+		// Paged and shared with clones
+		PagedArray<EntitySlot, SlotsPerPage> m_entitySlots; // Slot zero is reserved for the null ID
+		PagedArray<uint32_t, SlotsPerPage> m_availiableSlots;
+		PagedArray<HierarchyNode, SlotsPerPage> m_hierarchy; // Indexed by entity slot, grows when links are made
+
+		// Shared with clones as a whole, allocated with the first entity
+		std::shared_ptr<EntityList> m_usedIds;
+
+		// Lists keep the addresses the pools point to stable
+		std::pmr::list<OwningGroup> m_groups;
+		std::pmr::list<QueryCache> m_queries;
+
+		WIRE_STATS(RegistryCounters m_counters;)
 	};
 
-	template<typename T, typename ...Args>
-	inline T& Registry::AddComponent(EntityId aEntity, Args && ...args)
+	template<typename F>
+	inline void Registry::ForEachChild(EntityId parent, F&& func) const
 	{
-		const WireGUID guid = T::comp_guid;
+		const HierarchyNode* node = GetHierarchyNode(parent);
+		EntityId child = node ? node->firstChild : NullID;
 
-		auto it = m_pools.find(guid);
-		if (it != m_pools.end())
+		while (child != NullID)
 		{
-			T comp(std::forward<Args>(args)...);
-			return it->second.AddComponent<T>(aEntity, comp);
+			// Read the sibling first so that func may detach the child
+			const EntityId next = GetHierarchyNode(child)->nextSibling;
+			func(child);
+			child = next;
 		}
-		else
+	}
+
+	template<typename F>
+	inline void Registry::TraverseHierarchy(EntityId aRoot, F&& func) const
+	{
+		EntityId current = aRoot;
+
+		// Pre-order walk along the links, no stack needed
+		while (current != NullID)
 		{
-			m_pools.emplace(guid, ComponentPool(sizeof(T)));
+			func(current);
+
+			const HierarchyNode* node = GetHierarchyNode(current);
+			if (node && node->firstChild != NullID)
+			{
+				current = node->firstChild;
+				continue;
+			}
+
+			while (current != aRoot && GetHierarchyNode(current)->nextSibling == NullID)
+			{
+				current = GetHierarchyNode(current)->parent;
+			}
 
-			T comp(std::forward<Args>(args)...);
-			return m_pools[guid].AddComponent(aEntity, comp);
+			current = (current == aRoot) ? NullID : GetHierarchyNode(current)->nextSibling;
 		}
 	}
 
+	inline bool Registry::IsValid(EntityId aId) const
+	{
+		const uint32_t index = Entity::GetIndex(aId);
+		if (aId == NullID || index >= m_entitySlots.GetSize())
+		{
+			return false;
+		}
+
+		const EntitySlot& slot = m_entitySlots[index];
+		return slot.usedIndex != NullIndex && slot.version == Entity::GetVersion(aId);
+	}
+
+	template<typename F>
+	inline void Registry::ForEachUnsharedEntity(const Registry& aClone, F&& func) const
+	{
+		for (size_t page = 0; page < m_entitySlots.GetPageCount(); page++)
+		{
+			if (m_entitySlots.SharesPage(aClone.m_entitySlots, page))
+			{
+				continue;
+			}
+
+			const size_t end = std::min((page + 1) * SlotsPerPage, m_entitySlots.GetSize());
+			for (size_t index = std::max(page * SlotsPerPage, (size_t)1); index < end; index++)
+			{
+				const EntitySlot& slot = m_entitySlots[index];
+				if (slot.usedIndex != NullIndex)
+				{
+					func(Entity::Compose((uint32_t)index, slot.version));
+				}
+			}
+		}
+	}
+
+	template<typename T, typename ...Args>
+	inline T& Registry::AddComponent(EntityId aEntity, Args && ...args)
+	{
+		ComponentPool& pool = GetOrCreatePool<T>();
+		return pool.EmplaceComponent<T>(aEntity, std::forward<Args>(args)...);
+	}
+
+	template<typename T>
+	inline void Registry::AddComponents(std::span<const EntityId> aEntities, const T& aPrototype)
+	{
+		ComponentPool& pool = GetOrCreatePool<T>();
+		pool.AddComponentCopies(aEntities, std::span<const uint8_t>(reinterpret_cast<const uint8_t*>(&aPrototype), sizeof(T)));
+	}
+
+	template<typename T>
+	inline void Registry::AddComponents(std::span<const EntityId> aEntities, std::span<const T> aComponents)
+	{
+		assert(aEntities.size() == aComponents.size());
+
+		ComponentPool& pool = GetOrCreatePool<T>();
+		pool.AddComponents(aEntities, std::span<const uint8_t>(reinterpret_cast<const uint8_t*>(aComponents.data()), aComponents.size_bytes()));
+	}
+
 	template<typename T>
 	inline T& Registry::GetComponent(EntityId aEntity)
 	{
 		assert(HasComponent<T>(aEntity));
-		const WireGUID guid = T::comp_guid;
 
-		return m_pools.at(guid).GetComponent<T>(aEntity);
+		ComponentPool* pool = GetPool<T>();
+		return pool->GetComponent<T>(aEntity);
 	}
 
 	template<typename T>
 	inline bool Registry::HasComponent(EntityId aEntity) const
 	{
-		const WireGUID guid = T::comp_guid;
-		return m_pools.at(guid).HasComponent(aEntity);
+		const ComponentPool* pool = GetPool<T>();
+		return pool && pool->HasComponent(aEntity);
 	}
 
 	template<typename ...T>
@@ -118,23 +460,68 @@ namespace Wire
 	template<typename T>
 	inline void Registry::RemoveComponent(EntityId aEntity)
 	{
-		const WireGUID guid = T::comp_guid;
-
-		auto it = m_pools.find(guid);
-		assert(it != m_pools.end());
+		ComponentPool* pool = GetPool<T>();
+		assert(pool);
 
-		it->second.RemoveComponent(aEntity);
+		pool->RemoveComponent(aEntity);
 	}
 
 	template<typename T>
-	inline const std::vector<T>& Registry::GetAllComponents() const
+	inline std::vector<T> Registry::GetAllComponents() const
 	{
-		const WireGUID guid = T::comp_guid;
+		const ComponentPool* pool = GetPool<T>();
+		assert(pool);
 
-		auto it = m_pools.find(guid);
-		assert(it != m_pools.end());
+		std::vector<T> components;
+		components.reserve(pool->GetComponentView().size());
 
-		return reinterpret_cast<const std::vector<T>&>(it->second.GetAllComponents());
+		if (pool->HasColumnLayout())
+		{
+			components.resize(pool->GetComponentView().size());
+			for (size_t i = 0; i < components.size(); i++)
+			{
+				pool->CopyComponentData(pool->GetComponentView()[i], std::span<uint8_t>(reinterpret_cast<uint8_t*>(&components[i]), sizeof(T)));
+			}
+
+			return components;
+		}
+
+		// Copy constructs, which is a plain memmove for trivially copyable types
+		for (size_t page = 0; page < pool->GetPageCount(); page++)
+		{
+			const std::span<const uint8_t> pageData = pool->GetPageData(page);
+			const T* pageComponents = reinterpret_cast<const T*>(pageData.data());
+
+			components.insert(components.end(), pageComponents, pageComponents + pageData.size() / sizeof(T));
+		}
+
+		return components;
+	}
+
+	template<typename P>
+	inline const P& Registry::GetProperty(EntityId aEntity, const Property& aProperty) const
+	{
+		CheckPropertySize(aProperty, sizeof(P));
+		return *reinterpret_cast<const P*>(GetPropertyBytes(aEntity, aProperty).data());
+	}
+
+	template<typename P>
+	inline const P& Registry::GetProperty(EntityId aEntity, const WireGUID& guid, uint64_t aNameHash) const
+	{
+		return GetProperty<P>(aEntity, FindProperty(guid, aNameHash));
+	}
+
+	template<typename P>
+	inline void Registry::SetProperty(EntityId aEntity, const Property& aProperty, const P& value)
+	{
+		CheckPropertySize(aProperty, sizeof(P));
+		*reinterpret_cast<P*>(GetPropertyBytes(aEntity, aProperty).data()) = value;
+	}
+
+	template<typename P>
+	inline void Registry::SetProperty(EntityId aEntity, const WireGUID& guid, uint64_t aNameHash, const P& value)
+	{
+		SetProperty<P>(aEntity, FindProperty(guid, aNameHash), value);
 	}
 
 	inline std::unordered_map<WireGUID, std::vector<uint8_t>> Registry::GetComponents(EntityId aEntity) const
@@ -164,28 +551,142 @@ namespace Wire
 	}
 
 	template<typename T>
-	inline const std::vector<EntityId> Registry::GetComponentView() const
+	inline std::span<const EntityId> Registry::GetComponentView() const
+	{
+		if (const ComponentPool* pool = GetPool<T>())
+		{
+			return pool->GetComponentView();
+		}
+
+		return std::span<const EntityId>();
+	}
+
+	template<typename T>
+	inline void Registry::EnableChangeTracking()
 	{
-		const WireGUID guid = T::comp_guid;
+		GetOrCreatePool<T>().EnableChangeTracking();
+	}
 
+	template<typename T>
+	inline void Registry::MarkChanged(EntityId aEntity)
+	{
+		ComponentPool* pool = GetPool<T>();
+		assert(pool);
+
+		pool->MarkChanged(aEntity);
+	}
+
+	template<typename T, typename F>
+	inline void Registry::ForEachChanged(uint64_t aSinceTick, F&& func)
+	{
+		if (ComponentPool* pool = GetPool<T>())
+		{
+			pool->ForEachChanged<T>(aSinceTick, std::forward<F>(func));
+		}
+	}
+
+	template<typename ...T>
+	inline void Registry::CreateGroup()
+	{
+		static_assert(sizeof...(T) > 0, "A group needs at least one component type");
+
+		const std::array<ComponentPool*, sizeof...(T)> pools{ &GetOrCreatePool<T>()... };
+		m_groups.emplace_back(pools);
+	}
+
+	template<typename T>
+	inline void Registry::EnableColumnLayout()
+	{
+		static_assert(std::is_trivially_copyable_v<T>, "Column layouts need trivially copyable components");
+
+		GetOrCreatePool<T>();
+		EnableColumnLayout(T::comp_guid);
+	}
+
+	template<typename P>
+	inline ComponentColumn<P> Registry::GetColumn(const WireGUID& guid, const std::string& aPropertyName)
+	{
 		auto it = m_pools.find(guid);
-		if (it != m_pools.end())
+		if (it == m_pools.end())
 		{
-			return it->second.GetComponentView();
+			return ComponentColumn<P>();
 		}
 
-		return std::vector<EntityId>();
+		const size_t column = GetColumnIndex(guid, aPropertyName);
+		assert(column != ~size_t(0));
+
+		return ComponentColumn<P>(&it->second, column);
+	}
+
+	template<typename ...T>
+	inline View<T...> Registry::GetView()
+	{
+		return View<T...>({ GetPool<T>()... });
+	}
+
+	template<typename ...T>
+	inline Query<T...> Registry::GetQuery()
+	{
+		const std::array<ComponentPool*, sizeof...(T)> pools{ &GetOrCreatePool<std::remove_const_t<T>>()... };
+		return Query<T...>(&GetOrCreateQueryCache(pools), pools);
 	}
 
 	template<typename ...T, typename F>
 	inline void Registry::ForEach(F&& func)
 	{
-		for (const auto& id : m_usedIds)
+		const View<T...> view = GetView<T...>();
+		WIRE_STATS(m_counters.forEachCalls.Add());
+		WIRE_TRACE_SCOPE("ForEach", view.SizeHint(), &m_counters.forEachNanoseconds);
+
+		view.ForEach(std::forward<F>(func));
+	}
+
+	template<typename ...T, typename F>
+	inline void Registry::ParallelForEach(F&& func, JobSystem& jobSystem, size_t aChunkSize)
+	{
+		const View<T...> view = GetView<T...>();
+		WIRE_STATS(m_counters.forEachCalls.Add());
+		WIRE_TRACE_SCOPE("ParallelForEach", view.SizeHint(), &m_counters.forEachNanoseconds);
+
+		view.ParallelForEach(std::forward<F>(func), jobSystem, aChunkSize);
+	}
+
+	template<typename T>
+	inline const ComponentPool* Registry::GetPool() const
+	{
+		const uint32_t typeIndex = TypeIndex::Get<std::remove_const_t<T>>();
+		if (typeIndex < m_typedPools.size() && m_typedPools[typeIndex])
 		{
-			if (HasComponents<T...>(id))
-			{
-				func(id, GetComponent<T>(id)...);
-			}
+			return m_typedPools[typeIndex];
+		}
+
+		// Pools created from their GUID only are not cached until a non-const lookup finds them
+		auto it = m_pools.find(T::comp_guid);
+		return (it != m_pools.end()) ? &it->second : nullptr;
+	}
+
+	template<typename T>
+	inline ComponentPool* Registry::GetPool()
+	{
+		const uint32_t typeIndex = TypeIndex::Get<std::remove_const_t<T>>();
+		if (typeIndex < m_typedPools.size() && m_typedPools[typeIndex])
+		{
+			return m_typedPools[typeIndex];
+		}
+
+		// The pool may not exist yet or may have been created from its GUID only
+		return CachePool(typeIndex, T::comp_guid);
+	}
+
+	template<typename T>
+	inline ComponentPool& Registry::GetOrCreatePool()
+	{
+		if (ComponentPool* pool = GetPool<T>())
+		{
+			return *pool;
 		}
+
+		CreatePool(T::comp_guid, sizeof(T), ComponentOps::Get<T>(), alignof(T));
+		return *CachePool(TypeIndex::Get<std::remove_const_t<T>>(), T::comp_guid);
 	}
 }
\ No newline at end of file
@@ -2,6 +2,8 @@
 
 #include <fstream>
 #include <string>
+#include <algorithm>
+#include <cctype>
 
 namespace Wire
 {
@@ -39,16 +41,453 @@ namespace Wire
 
 			return ComponentRegistry::PropertyType::Unknown;
 		}
+
+		static std::string Trim(const std::string& string)
+		{
+			const size_t begin = string.find_first_not_of(" \t\r\n");
+			if (begin == std::string::npos)
+			{
+				return std::string();
+			}
+
+			const size_t end = string.find_last_not_of(" \t\r\n");
+			return string.substr(begin, end - begin + 1);
+		}
+
+		static bool IsIdentifierChar(char character)
+		{
+			return std::isalnum((unsigned char)character) || character == '_';
+		}
+
+		static uint64_t HashCombine(uint64_t hash, uint64_t value)
+		{
+			for (size_t i = 0; i < sizeof(uint64_t); i++)
+			{
+				hash = (hash ^ ((value >> (i * 8)) & 0xFF)) * 1099511628211ull;
+			}
+
+			return hash;
+		}
+
+		template<typename T>
+		static void Append(std::vector<uint8_t>& outData, const T& value)
+		{
+			const size_t offset = outData.size();
+			outData.resize(offset + sizeof(T));
+			memcpy(&outData[offset], &value, sizeof(T));
+		}
+
+		template<typename T>
+		static bool Read(std::span<const uint8_t> data, size_t& offset, T& outValue)
+		{
+			if (offset + sizeof(T) > data.size())
+			{
+				return false;
+			}
+
+			memcpy(&outValue, &data[offset], sizeof(T));
+			offset += sizeof(T);
+			return true;
+		}
+
+		// A component layout as it was when the data was saved
+		struct SavedProperty
+		{
+			uint64_t nameHash = 0;
+			ComponentRegistry::PropertyType type = ComponentRegistry::PropertyType::Unknown;
+			uint32_t offset = 0;
+		};
+
+		struct SavedSchema
+		{
+			uint64_t layoutHash = 0;
+			uint32_t size = 0;
+			std::vector<SavedProperty> properties;
+		};
+
+		static void WriteSchema(std::vector<uint8_t>& outData, const ComponentRegistry::RegistrationInfo& info)
+		{
+			Append(outData, info.layoutHash);
+			Append(outData, (uint32_t)info.properties.size());
+
+			for (const auto& property : info.properties)
+			{
+				Append(outData, property.nameHash);
+				Append(outData, property.type);
+				Append(outData, (uint32_t)property.offset);
+			}
+		}
+
+		// outSchema.size must be set, properties that do not fit in it fail the read
+		static bool ReadSchema(std::span<const uint8_t> data, size_t& offset, SavedSchema& outSchema)
+		{
+			uint32_t propertyCount = 0;
+			if (!Read(data, offset, outSchema.layoutHash) || !Read(data, offset, propertyCount))
+			{
+				return false;
+			}
+
+			outSchema.properties.resize(propertyCount);
+			for (SavedProperty& property : outSchema.properties)
+			{
+				if (!Read(data, offset, property.nameHash) || !Read(data, offset, property.type) || !Read(data, offset, property.offset) ||
+					property.type >= ComponentRegistry::PropertyType::Unknown || property.offset + ComponentRegistry::GetSizeFromType(property.type) > outSchema.size)
+				{
+					return false;
+				}
+			}
+
+			return true;
+		}
+
+		template<typename T>
+		static double ReadAs(const uint8_t* source)
+		{
+			T value;
+			memcpy(&value, source, sizeof(T));
+			return (double)value;
+		}
+
+		template<typename T>
+		static void WriteAs(double number, uint8_t* destination)
+		{
+			T value;
+			if constexpr (std::is_same_v<T, bool>)
+			{
+				value = number != 0.0;
+			}
+			else if constexpr (std::is_integral_v<T>)
+			{
+				value = (T)(int64_t)number;
+			}
+			else
+			{
+				value = (T)number;
+			}
+
+			memcpy(destination, &value, sizeof(T));
+		}
+
+		// Returns false for types that are not numbers
+		static bool ReadNumber(ComponentRegistry::PropertyType type, const uint8_t* source, double& outNumber)
+		{
+			switch (type)
+			{
+				case ComponentRegistry::PropertyType::Bool: outNumber = ReadAs<bool>(source); return true;
+				case ComponentRegistry::PropertyType::Int: outNumber = ReadAs<int32_t>(source); return true;
+				case ComponentRegistry::PropertyType::UInt: outNumber = ReadAs<uint32_t>(source); return true;
+				case ComponentRegistry::PropertyType::Short: outNumber = ReadAs<int16_t>(source); return true;
+				case ComponentRegistry::PropertyType::UShort: outNumber = ReadAs<uint16_t>(source); return true;
+				case ComponentRegistry::PropertyType::Char: outNumber = ReadAs<int8_t>(source); return true;
+				case ComponentRegistry::PropertyType::UChar: outNumber = ReadAs<uint8_t>(source); return true;
+				case ComponentRegistry::PropertyType::Float: outNumber = ReadAs<float>(source); return true;
+				case ComponentRegistry::PropertyType::Double: outNumber = ReadAs<double>(source); return true;
+				default: return false;
+			}
+		}
+
+		// Returns false and leaves destination untouched for types that are not numbers
+		static bool WriteNumber(ComponentRegistry::PropertyType type, double number, uint8_t* destination)
+		{
+			switch (type)
+			{
+				case ComponentRegistry::PropertyType::Bool: WriteAs<bool>(number, destination); return true;
+				case ComponentRegistry::PropertyType::Int: WriteAs<int32_t>(number, destination); return true;
+				case ComponentRegistry::PropertyType::UInt: WriteAs<uint32_t>(number, destination); return true;
+				case ComponentRegistry::PropertyType::Short: WriteAs<int16_t>(number, destination); return true;
+				case ComponentRegistry::PropertyType::UShort: WriteAs<uint16_t>(number, destination); return true;
+				case ComponentRegistry::PropertyType::Char: WriteAs<int8_t>(number, destination); return true;
+				case ComponentRegistry::PropertyType::UChar: WriteAs<uint8_t>(number, destination); return true;
+				case ComponentRegistry::PropertyType::Float: WriteAs<float>(number, destination); return true;
+				case ComponentRegistry::PropertyType::Double: WriteAs<double>(number, destination); return true;
+				default: return false;
+			}
+		}
+
+		/*
+		* Writes the saved component into destination in the registered layout, returns false if it can not be migrated.
+		* Only trivially copyable components with a known layout are migrated, they are built from zeroed memory.
+		* Components with ops are never loaded, their saved bytes are not objects.
+		*/
+		static bool LoadComponent(const SavedSchema& schema, const uint8_t* source, const ComponentRegistry::RegistrationInfo& info, uint8_t* destination)
+		{
+			if (info.ops)
+			{
+				return false;
+			}
+
+			if (schema.layoutHash == info.layoutHash && schema.size == info.size)
+			{
+				memcpy(destination, source, info.size);
+				return true;
+			}
+
+			if (!info.hasLayout)
+			{
+				return false;
+			}
+
+			memset(destination, 0, info.size);
+
+			for (const auto& property : info.properties)
+			{
+				auto saved = std::find_if(schema.properties.begin(), schema.properties.end(), [&](const SavedProperty& savedProperty) { return savedProperty.nameHash == property.nameHash; });
+				if (saved == schema.properties.end())
+				{
+					continue;
+				}
+
+				if (saved->type == property.type)
+				{
+					memcpy(destination + property.offset, source + saved->offset, property.size);
+				}
+				else
+				{
+					// Numbers convert between types, any other type change leaves the property zeroed
+					double number = 0.0;
+					if (ReadNumber(saved->type, source + saved->offset, number))
+					{
+						WriteNumber(property.type, number, destination + property.offset);
+					}
+				}
+			}
+
+			return true;
+		}
+
+		struct StagedComponent
+		{
+			EntityId entity = NullID;
+			WireGUID guid;
+			uint32_t size = 0;
+			size_t dataOffset = 0;
+		};
+
+		// Decoded entities waiting to be inserted into a registry
+		struct StagingBuffer
+		{
+			std::vector<EntityId> entities;
+			std::vector<size_t> firstComponents; // Index of every entity's first staged component
+			std::vector<StagedComponent> components;
+			std::vector<uint8_t> componentData;
+
+			std::vector<uint8_t> fileData; // Reused between files
+		};
+
+		static bool ReadFile(const std::filesystem::path& aPath, std::vector<uint8_t>& outData)
+		{
+			std::ifstream file(aPath, std::ios::binary);
+			if (!file.is_open())
+			{
+				return false;
+			}
+
+			outData.resize(file.seekg(0, std::ios::end).tellg());
+			file.seekg(0, std::ios::beg);
+			file.read(reinterpret_cast<char*>(outData.data()), outData.size());
+			file.close();
+
+			return true;
+		}
+
+		// Appends the entity in buffer.fileData to the buffer, returns false if the file is truncated
+		static bool DecodeEntityData(StagingBuffer& buffer)
+		{
+			const std::vector<uint8_t>& totalData = buffer.fileData;
+			size_t offset = 0;
+
+			EntityId id = NullID;
+			uint32_t componentCount = 0;
+			if (!Read(totalData, offset, id) || !Read(totalData, offset, componentCount))
+			{
+				return false;
+			}
+
+			buffer.entities.emplace_back(id);
+			buffer.firstComponents.emplace_back(buffer.components.size());
+
+			for (uint32_t i = 0; i < componentCount; i++)
+			{
+				uint16_t nameSize = 0;
+				if (!Read(totalData, offset, nameSize))
+				{
+					return false;
+				}
+
+				if (nameSize == Serializer::SchemaEncodingTag)
+				{
+					WireGUID guid;
+					SavedSchema schema;
+					if (!Read(totalData, offset, guid) || !Read(totalData, offset, schema.size) || !ReadSchema(totalData, offset, schema) ||
+						offset + schema.size > totalData.size())
+					{
+						return false;
+					}
+
+					const uint8_t* source = &totalData[offset];
+					offset += schema.size;
+
+					// The saved size lets unregistered components be skipped
+					const ComponentRegistry::RegistrationInfo& registryData = ComponentRegistry::GetRegistryDataFromGUID(guid);
+					if (registryData.guid.IsNull())
+					{
+						continue;
+					}
+
+					const size_t dataOffset = buffer.componentData.size();
+					buffer.componentData.resize(dataOffset + registryData.size);
+
+					if (!LoadComponent(schema, source, registryData, &buffer.componentData[dataOffset]))
+					{
+						buffer.componentData.resize(dataOffset);
+						continue;
+					}
+
+					StagedComponent& component = buffer.components.emplace_back();
+					component.entity = id;
+					component.guid = registryData.guid;
+					component.size = (uint32_t)registryData.size;
+					component.dataOffset = dataOffset;
+					continue;
+				}
+
+				const ComponentRegistry::RegistrationInfo* registryDataPtr = nullptr;
+				if (nameSize == Serializer::GUIDEncodingTag)
+				{
+					WireGUID guid;
+					if (!Read(totalData, offset, guid))
+					{
+						return false;
+					}
+
+					registryDataPtr = &ComponentRegistry::GetRegistryDataFromGUID(guid);
+				}
+				else
+				{
+					if (offset + nameSize > totalData.size())
+					{
+						return false;
+					}
+
+					std::string name(reinterpret_cast<const char*>(&totalData[offset]), nameSize);
+					offset += nameSize;
+
+					registryDataPtr = &ComponentRegistry::GetRegistryDataFromName(name);
+				}
+
+				// Without a schema the size comes from the registration, the rest of the file can not be located after an unregistered component
+				const ComponentRegistry::RegistrationInfo& registryData = *registryDataPtr;
+				if (registryData.guid.IsNull())
+				{
+					return true;
+				}
+
+				if (offset + registryData.size > totalData.size())
+				{
+					return false;
+				}
+
+				if (registryData.ops)
+				{
+					offset += registryData.size;
+					continue;
+				}
+
+				StagedComponent& component = buffer.components.emplace_back();
+				component.entity = id;
+				component.guid = registryData.guid;
+				component.size = (uint32_t)registryData.size;
+				component.dataOffset = buffer.componentData.size();
+
+				buffer.componentData.insert(buffer.componentData.end(), &totalData[offset], &totalData[offset] + registryData.size);
+				offset += registryData.size;
+			}
+
+			return true;
+		}
+
+		// Decodes the entity file in buffer.fileData, a file that can not be decoded leaves the buffer as it was
+		static bool DecodeEntity(StagingBuffer& buffer)
+		{
+			const size_t entityCount = buffer.entities.size();
+			const size_t componentCount = buffer.components.size();
+			const size_t dataSize = buffer.componentData.size();
+
+			if (DecodeEntityData(buffer))
+			{
+				return true;
+			}
+
+			buffer.entities.resize(entityCount);
+			buffer.firstComponents.resize(entityCount);
+			buffer.components.resize(componentCount);
+			buffer.componentData.resize(dataSize);
+			return false;
+		}
+
+		// Inserts the staged entities, the components are grouped per pool and added in bulk.
+		// Entities whose id is already in use are dropped from the buffer together with their components.
+		static void CommitStaging(std::span<StagingBuffer> buffers, Registry& aRegistry)
+		{
+			struct PoolBatch
+			{
+				uint32_t size = 0;
+				std::vector<EntityId> entities;
+				std::vector<uint8_t> data;
+			};
+
+			std::unordered_map<WireGUID, PoolBatch> batches;
+
+			for (auto& buffer : buffers)
+			{
+				size_t added = 0;
+				for (size_t i = 0; i < buffer.entities.size(); i++)
+				{
+					if (aRegistry.AddEntity(buffer.entities[i]) == NullID)
+					{
+						continue;
+					}
+
+					buffer.entities[added++] = buffer.entities[i];
+
+					const size_t lastComponent = i + 1 < buffer.firstComponents.size() ? buffer.firstComponents[i + 1] : buffer.components.size();
+					for (size_t c = buffer.firstComponents[i]; c < lastComponent; c++)
+					{
+						const StagedComponent& component = buffer.components[c];
+
+						// Components that are not registered can not be sized, so they are skipped
+						if (component.guid.IsNull())
+						{
+							continue;
+						}
+
+						PoolBatch& batch = batches[component.guid];
+						batch.size = component.size;
+						batch.entities.emplace_back(component.entity);
+						batch.data.insert(batch.data.end(), &buffer.componentData[component.dataOffset], &buffer.componentData[component.dataOffset] + component.size);
+					}
+				}
+
+				buffer.entities.resize(added);
+			}
+
+			for (const auto& [guid, batch] : batches)
+			{
+				aRegistry.AddComponents(batch.entities, batch.data, guid, batch.size);
+			}
+		}
 	}
 
 	bool ComponentRegistry::Register(const std::string& name, const std::string& definitionData, const RegistrationInfo& guid)
 	{
 		if (auto it = ComponentGUIDs().find(name); it == ComponentGUIDs().end())
 		{
-			ComponentGUIDs()[name] = guid;
-			ComponentGUIDs()[name].name = name;
+			RegistrationInfo& info = ComponentGUIDs()[name];
+			info = guid;
+			info.name = name;
 			
-			ParseDefinition(definitionData, ComponentGUIDs()[name]);
+			ParseDefinition(definitionData, info);
+			GUIDIndex()[info.guid] = &info;
 			return true;
 		}
 
@@ -57,12 +496,9 @@ namespace Wire
 
 	const std::string ComponentRegistry::GetNameFromGUID(const WireGUID& aGuid)
 	{
-		for (const auto& it : ComponentGUIDs())
+		if (auto it = GUIDIndex().find(aGuid); it != GUIDIndex().end())
 		{
-			if (it.second.guid == aGuid)
-			{
-				return it.first;
-			}
+			return it->second->name;
 		}
 
 		return "Null";
@@ -81,66 +517,172 @@ namespace Wire
 
 	const ComponentRegistry::RegistrationInfo& ComponentRegistry::GetRegistryDataFromGUID(const WireGUID& aGuid)
 	{
-		for (const auto& [name, info] : ComponentGUIDs())
+		if (auto it = GUIDIndex().find(aGuid); it != GUIDIndex().end())
 		{
-			if (info.guid == aGuid)
-			{
-				return info;
-			}
+			return *it->second;
 		}
 
 		static RegistrationInfo empty;
 		return empty;
 	}
 
+	const ComponentRegistry::ComponentProperty* ComponentRegistry::FindProperty(const RegistrationInfo& aInfo, uint64_t aNameHash)
+	{
+		// Components have few properties, a linear scan over the hashes beats a map
+		for (const ComponentProperty& property : aInfo.properties)
+		{
+			if (property.nameHash == aNameHash)
+			{
+				return &property;
+			}
+		}
+
+		return nullptr;
+	}
+
 	std::unordered_map<std::string, ComponentRegistry::RegistrationInfo>& ComponentRegistry::ComponentGUIDs()
 	{
 		static std::unordered_map<std::string, RegistrationInfo> impl;
 		return impl;
 	}
 
+	std::unordered_map<WireGUID, const ComponentRegistry::RegistrationInfo*>& ComponentRegistry::GUIDIndex()
+	{
+		static std::unordered_map<WireGUID, const RegistrationInfo*> impl;
+		return impl;
+	}
+
 	void ComponentRegistry::ParseDefinition(const std::string& definitionData, RegistrationInfo& outInfo)
 	{
-		// Find first {, which is the start of the component
-		auto it = definitionData.find('{');
+		// The body lies between the first { and the last }, the GUID string inside it has no ;
+		const size_t bodyBegin = definitionData.find('{');
+		const size_t bodyEnd = definitionData.rfind('}');
+		if (bodyBegin == std::string::npos || bodyEnd == std::string::npos || bodyEnd < bodyBegin)
+		{
+			return;
+		}
+
+		bool layoutKnown = true;
+		size_t offset = 0;
+		size_t maxAlignment = 1;
 
-		while (it != std::string::npos)
+		size_t declarationBegin = bodyBegin + 1;
+		while (declarationBegin < bodyEnd)
 		{
-			it = definitionData.find_first_of("abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ", it);
-			if (it == std::string::npos)
+			size_t declarationEnd = definitionData.find(';', declarationBegin);
+			if (declarationEnd == std::string::npos || declarationEnd > bodyEnd)
 			{
-				break;
+				declarationEnd = bodyEnd;
 			}
 
-			auto spaceIt = definitionData.find_first_of(' ', it);
-			PropertyType type = Utility::PropertyFromString(definitionData.substr(it, spaceIt - it));
+			std::string declaration = Utility::Trim(definitionData.substr(declarationBegin, declarationEnd - declarationBegin));
+			declarationBegin = declarationEnd + 1;
 
-			auto nameEndIt = definitionData.find_first_of(";", spaceIt);
-			std::string name = definitionData.substr(spaceIt + 1, nameEndIt - spaceIt - 1);
-			name[0] = toupper(name[0]);
+			if (declaration.rfind("PROPERTY(", 0) == 0)
+			{
+				declaration = Utility::Trim(declaration.substr(declaration.find(')') + 1));
+			}
 
-			if (type != PropertyType::Unknown)
+			// Not data members of the component
+			if (declaration.empty() || declaration.rfind("CREATE_COMPONENT_GUID", 0) == 0 || declaration.rfind("static ", 0) == 0 ||
+				declaration.rfind("inline ", 0) == 0 || declaration.rfind("using ", 0) == 0)
 			{
-				auto& property = outInfo.properties.emplace_back();
-				property.name = name;
-				property.type = type;
+				continue;
 			}
 
-			it = definitionData.find_first_of("abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ", nameEndIt);
+			// Drop default member initializers
+			declaration = Utility::Trim(declaration.substr(0, declaration.find_first_of("={")));
+
+			size_t nameBegin = declaration.size();
+			while (nameBegin > 0 && Utility::IsIdentifierChar(declaration[nameBegin - 1]))
+			{
+				nameBegin--;
+			}
+
+			std::string name = declaration.substr(nameBegin);
+			std::string typeName;
+			for (const char character : Utility::Trim(declaration.substr(0, nameBegin)))
+			{
+				// Collapse whitespace so that "unsigned  int" matches
+				if (!std::isspace((unsigned char)character) || (!typeName.empty() && typeName.back() != ' '))
+				{
+					typeName += std::isspace((unsigned char)character) ? ' ' : character;
+				}
+			}
+
+			const PropertyType type = (name.empty() || typeName.empty()) ? PropertyType::Unknown : Utility::PropertyFromString(typeName);
+			if (type == PropertyType::Unknown)
+			{
+				layoutKnown = false;
+				continue;
+			}
+
+			const size_t alignment = GetAlignmentFromType(type);
+			offset = (offset + alignment - 1) / alignment * alignment;
+			maxAlignment = std::max(maxAlignment, alignment);
+
+			name[0] = toupper(name[0]);
+
+			auto& property = outInfo.properties.emplace_back();
+			property.name = name;
+			property.type = type;
+			property.offset = offset;
+			property.size = GetSizeFromType(type);
+			property.nameHash = HashPropertyName(name);
+
+			offset += property.size;
 		}
+
+		const size_t alignment = std::max(maxAlignment, outInfo.alignment);
+		const size_t layoutSize = (offset + alignment - 1) / alignment * alignment;
+
+		outInfo.hasLayout = layoutKnown && !outInfo.properties.empty() && layoutSize == outInfo.size;
+
+		uint64_t layoutHash = Utility::HashCombine(14695981039346656037ull, outInfo.size);
+		layoutHash = Utility::HashCombine(layoutHash, outInfo.hasLayout);
+
+		for (const auto& property : outInfo.properties)
+		{
+			layoutHash = Utility::HashCombine(layoutHash, property.nameHash);
+			layoutHash = Utility::HashCombine(layoutHash, (uint64_t)property.type);
+			layoutHash = Utility::HashCombine(layoutHash, property.offset);
+		}
+
+		outInfo.layoutHash = layoutHash;
 	}
 
 	void Serializer::SerializeEntityToFile(EntityId aId, const Registry& aRegistry, const std::filesystem::path& aSceneFolder)
 	{
 		std::vector<uint8_t> data;
-		const std::vector<uint8_t> encodedComponentData = aRegistry.GetEntityComponentDataEncoded(aId);
-		const uint32_t componentCount = aRegistry.GetComponentCount(aId);
+		Utility::Append(data, aId);
+
+		const size_t componentCountOffset = data.size();
+		uint32_t componentCount = 0;
+		Utility::Append(data, componentCount);
+
+		for (const auto& [guid, pool] : aRegistry.GetPools())
+		{
+			// Components with ops can not be saved as bytes
+			if (!pool.HasComponent(aId) || pool.GetOps())
+			{
+				continue;
+			}
 
-		data.resize(sizeof(EntityId) + sizeof(uint32_t) + encodedComponentData.size());
+			componentCount++;
 
-		memcpy_s(data.data(), sizeof(EntityId), &aId, sizeof(EntityId));
-		memcpy_s(&data[sizeof(EntityId)], sizeof(uint32_t), &componentCount, sizeof(uint32_t));
-		memcpy_s(&data[sizeof(EntityId) + sizeof(uint32_t)], encodedComponentData.size(), encodedComponentData.data(), encodedComponentData.size());
+			const uint32_t componentSize = pool.GetComponentSize();
+
+			Utility::Append(data, SchemaEncodingTag);
+			Utility::Append(data, guid);
+			Utility::Append(data, componentSize);
+			Utility::WriteSchema(data, ComponentRegistry::GetRegistryDataFromGUID(guid));
+
+			const size_t dataOffset = data.size();
+			data.resize(dataOffset + componentSize);
+			pool.CopyComponentData(aId, std::span<uint8_t>(data).subspan(dataOffset, componentSize));
+		}
+
+		memcpy(&data[componentCountOffset], &componentCount, sizeof(uint32_t));
 
 		if (!std::filesystem::exists(aSceneFolder))
 		{
@@ -156,12 +698,133 @@ namespace Wire
 
 	EntityId Serializer::DeserializeEntityToRegistry(const std::filesystem::path& aPath, Registry& aRegistry)
 	{
-		std::ifstream file(aPath.string(), std::ios::binary);
-		if (!file.is_open())
+		Utility::StagingBuffer buffer;
+		if (!Utility::ReadFile(aPath, buffer.fileData) || !Utility::DecodeEntity(buffer))
 		{
 			return 0;
 		}
 
+		Utility::CommitStaging(std::span<Utility::StagingBuffer>(&buffer, 1), aRegistry);
+
+		return buffer.entities.empty() ? NullID : buffer.entities.front();
+	}
+
+	std::vector<EntityId> Serializer::DeserializeSceneFolder(const std::filesystem::path& aSceneFolder, Registry& aRegistry, JobSystem& jobSystem)
+	{
+		std::vector<std::filesystem::path> paths;
+		if (std::filesystem::exists(aSceneFolder))
+		{
+			for (const auto& entry : std::filesystem::directory_iterator(aSceneFolder))
+			{
+				if (entry.is_regular_file() && entry.path().extension() == ".ent")
+				{
+					paths.emplace_back(entry.path());
+				}
+			}
+		}
+
+		// Every chunk decodes into its own staging buffer, so the workers never share state
+		constexpr size_t filesPerChunk = 64;
+		std::vector<Utility::StagingBuffer> buffers((paths.size() + filesPerChunk - 1) / filesPerChunk);
+
+		jobSystem.ParallelFor(paths.size(), filesPerChunk, [&](size_t begin, size_t end)
+			{
+				Utility::StagingBuffer& buffer = buffers[begin / filesPerChunk];
+				for (size_t i = begin; i < end; i++)
+				{
+					// Files that can not be read or decoded are skipped
+					if (Utility::ReadFile(paths[i], buffer.fileData))
+					{
+						Utility::DecodeEntity(buffer);
+					}
+				}
+			});
+
+		Utility::CommitStaging(buffers, aRegistry);
+
+		std::vector<EntityId> entities;
+		for (const auto& buffer : buffers)
+		{
+			entities.insert(entities.end(), buffer.entities.begin(), buffer.entities.end());
+		}
+
+		return entities;
+	}
+
+	void Serializer::SerializeRegistry(const Registry& aRegistry, const std::filesystem::path& aPath)
+	{
+		if (aPath.has_parent_path() && !std::filesystem::exists(aPath.parent_path()))
+		{
+			std::filesystem::create_directories(aPath.parent_path());
+		}
+
+		std::ofstream file(aPath, std::ios::binary);
+
+		auto write = [&file](const void* data, size_t size)
+		{
+			file.write(reinterpret_cast<const char*>(data), size);
+		};
+
+		const std::span<const EntityId> entities = aRegistry.GetAllEntities();
+		const uint32_t entityCount = (uint32_t)entities.size();
+		const uint32_t poolCount = (uint32_t)std::count_if(aRegistry.GetPools().begin(), aRegistry.GetPools().end(), [](const auto& pool) { return !pool.second.GetOps(); });
+
+		write(&RegistryFileMagic, sizeof(uint32_t));
+		write(&RegistryFileVersion, sizeof(uint32_t));
+		write(&entityCount, sizeof(uint32_t));
+		write(entities.data(), entities.size() * sizeof(EntityId));
+		write(&poolCount, sizeof(uint32_t));
+
+		for (const auto& [guid, pool] : aRegistry.GetPools())
+		{
+			if (pool.GetOps())
+			{
+				continue;
+			}
+
+			const std::span<const EntityId> poolEntities = pool.GetComponentView();
+			const uint32_t componentSize = pool.GetComponentSize();
+			const uint32_t componentCount = (uint32_t)poolEntities.size();
+
+			std::vector<uint8_t> schema;
+			Utility::WriteSchema(schema, ComponentRegistry::GetRegistryDataFromGUID(guid));
+
+			write(&guid, sizeof(WireGUID));
+			write(&componentSize, sizeof(uint32_t));
+			write(&componentCount, sizeof(uint32_t));
+			write(schema.data(), schema.size());
+			write(poolEntities.data(), poolEntities.size() * sizeof(EntityId));
+
+			if (pool.HasColumnLayout())
+			{
+				std::vector<uint8_t> componentData(componentSize);
+				for (const EntityId id : poolEntities)
+				{
+					pool.CopyComponentData(id, componentData);
+					write(componentData.data(), componentData.size());
+				}
+			}
+			else
+			{
+				for (size_t page = 0; page < pool.GetPageCount(); page++)
+				{
+					const std::span<const uint8_t> pageData = pool.GetPageData(page);
+					write(pageData.data(), pageData.size());
+				}
+			}
+		}
+
+		file.close();
+	}
+
+	bool Serializer::DeserializeRegistry(const std::filesystem::path& aPath, Registry& aRegistry)
+	{
+		std::ifstream file(aPath, std::ios::binary);
+		if (!file.is_open())
+		{
+			return false;
+		}
+
 		std::vector<uint8_t> totalData;
 		totalData.resize(file.seekg(0, std::ios::end).tellg());
 		file.seekg(0, std::ios::beg);
@@ -170,33 +833,120 @@ namespace Wire
 
 		size_t offset = 0;
 
-		const EntityId id = *reinterpret_cast<EntityId*>(&totalData[offset]);
-		aRegistry.AddEntity(id);
+		auto read = [&](void* outData, size_t size)
+		{
+			if (offset + size > totalData.size())
+			{
+				return false;
+			}
 
-		offset += sizeof(EntityId);
+			memcpy(outData, &totalData[offset], size);
+			offset += size;
+			return true;
+		};
 
-		const uint32_t componentCount = *reinterpret_cast<uint32_t*>(&totalData[offset]);
-		offset += sizeof(uint32_t);
+		auto readSpan = [&](size_t size, std::span<const uint8_t>& outSpan)
+		{
+			if (offset + size > totalData.size())
+			{
+				return false;
+			}
 
-		for (uint32_t i = 0; i < componentCount; i++)
+			outSpan = std::span<const uint8_t>(totalData.data() + offset, size);
+			offset += size;
+			return true;
+		};
+
+		uint32_t magic = 0;
+		uint32_t version = 0;
+		uint32_t entityCount = 0;
+
+		if (!read(&magic, sizeof(uint32_t)) || magic != RegistryFileMagic ||
+			!read(&version, sizeof(uint32_t)) || version == 0 || version > RegistryFileVersion ||
+			!read(&entityCount, sizeof(uint32_t)))
 		{
-			const uint16_t nameSize = *reinterpret_cast<uint16_t*>(&totalData[offset]);
-			offset += sizeof(uint16_t);
+			return false;
+		}
 
-			std::string name(reinterpret_cast<char*>(&totalData[offset]), nameSize);
+		std::vector<EntityId> entities(entityCount);
+		if (!read(entities.data(), entities.size() * sizeof(EntityId)))
+		{
+			return false;
+		}
 
-			offset += nameSize;
+		// The saved ids must be free, otherwise the saved components would land on live entities
+		for (size_t i = 0; i < entities.size(); i++)
+		{
+			if (aRegistry.AddEntity(entities[i]) == NullID)
+			{
+				for (size_t added = 0; added < i; added++)
+				{
+					aRegistry.RemoveEntity(entities[added]);
+				}
 
-			const ComponentRegistry::RegistrationInfo& registryData = ComponentRegistry::GetRegistryDataFromName(name);
+				return false;
+			}
+		}
 
-			std::vector<uint8_t> componentData;
-			componentData.resize(registryData.size);
-			memcpy_s(componentData.data(), componentData.size(), &totalData[offset], registryData.size);
-			offset += registryData.size;
+		uint32_t poolCount = 0;
+		if (!read(&poolCount, sizeof(uint32_t)))
+		{
+			return false;
+		}
+
+		std::vector<EntityId> poolEntities;
+		std::vector<EntityId> migratedEntities;
+		std::vector<uint8_t> migratedData;
+
+		for (uint32_t i = 0; i < poolCount; i++)
+		{
+			WireGUID guid;
+			Utility::SavedSchema schema;
+			uint32_t componentCount = 0;
+
+			if (!read(&guid, sizeof(WireGUID)) || !read(&schema.size, sizeof(uint32_t)) || !read(&componentCount, sizeof(uint32_t)) ||
+				(version >= 2 && !Utility::ReadSchema(totalData, offset, schema)))
+			{
+				return false;
+			}
+
+			poolEntities.resize(componentCount);
+
+			std::span<const uint8_t> componentData;
+			if (!read(poolEntities.data(), poolEntities.size() * sizeof(EntityId)) || !readSpan((size_t)componentCount * schema.size, componentData))
+			{
+				return false;
+			}
+
+			// Version 1 files and unregistered components are loaded as saved, components with ops are never loaded
+			const ComponentRegistry::RegistrationInfo& registryData = ComponentRegistry::GetRegistryDataFromGUID(guid);
+			if (registryData.ops)
+			{
+				continue;
+			}
+
+			if (version < 2 || registryData.guid.IsNull() || (schema.layoutHash == registryData.layoutHash && schema.size == registryData.size))
+			{
+				aRegistry.AddComponents(poolEntities, componentData, guid, schema.size);
+				continue;
+			}
+
+			migratedEntities.clear();
+			migratedData.resize((size_t)componentCount * registryData.size);
+
+			for (uint32_t component = 0; component < componentCount; component++)
+			{
+				uint8_t* destination = &migratedData[migratedEntities.size() * registryData.size];
+				if (Utility::LoadComponent(schema, &componentData[(size_t)component * schema.size], registryData, destination))
+				{
+					migratedEntities.emplace_back(poolEntities[component]);
+				}
+			}
 
-			aRegistry.AddComponent(componentData, registryData.guid, id);
+			migratedData.resize(migratedEntities.size() * registryData.size);
+			aRegistry.AddComponents(migratedEntities, migratedData, guid, (uint32_t)registryData.size);
 		}
 
-		return id;
+		return true;
 	}
-}
+}
\ No newline at end of file
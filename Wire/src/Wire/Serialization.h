@@ -2,13 +2,15 @@
 
 #include "WireGUID.h"
 #include "Registry.h"
+#include "JobSystem.h"
 
 #include <unordered_map>
 #include <filesystem>
+#include <string_view>
 
 #define CREATE_COMPONENT_GUID(guid) inline static constexpr WireGUID comp_guid = guid;
 #define SERIALIZE_COMPONENT(definition, type) definition; \
-inline static bool type##_reg = Wire::ComponentRegistry::Register(#type, #definition, { type::comp_guid, sizeof(type) });
+inline static bool type##_reg = Wire::ComponentRegistry::Register(#type, #definition, { type::comp_guid, sizeof(type), Wire::ComponentOps::Get<type>(), alignof(type) });
 
 
 #define PROPERTY(...)
@@ -58,19 +60,57 @@ namespace Wire
 			return 0;
 		}
 
+		inline static const size_t GetAlignmentFromType(PropertyType type)
+		{
+			switch (type)
+			{
+				case ComponentRegistry::PropertyType::Vector2:
+				case ComponentRegistry::PropertyType::Vector3:
+				case ComponentRegistry::PropertyType::Vector4: return alignof(float);
+				case ComponentRegistry::PropertyType::String: return alignof(std::string);
+				default: break;
+			}
+
+			return GetSizeFromType(type);
+		}
+
+		// Offset and size are only valid if the component's hasLayout is set
 		struct ComponentProperty
 		{
 			std::string name;
 			PropertyType type;
+			size_t offset = 0;
+			size_t size = 0;
+			uint64_t nameHash = 0;
 		};
 
+		// FNV-1a, hash a name once and look the property up by hash on every access
+		inline static constexpr uint64_t HashPropertyName(std::string_view aName)
+		{
+			uint64_t hash = 14695981039346656037ull;
+			for (const char character : aName)
+			{
+				hash = (hash ^ (uint8_t)character) * 1099511628211ull;
+			}
+
+			return hash;
+		}
+
 		struct RegistrationInfo
 		{
 			WireGUID guid = WireGUID::Null();
 			size_t size = 0;
+			const ComponentOps* ops = nullptr; // nullptr for trivially copyable components
+			size_t alignment = 0;
 			std::string name;
 
 			std::vector<ComponentProperty> properties;
+
+			// Set when every data member has a known type and the computed layout matches the size of the type
+			bool hasLayout = false;
+
+			// Hash of the size and the parsed properties, saved with the component data to detect layout changes
+			uint64_t layoutHash = 0;
 		};
 
 		ComponentRegistry() = delete;
@@ -82,7 +122,13 @@ namespace Wire
 
 		static std::unordered_map<std::string, RegistrationInfo>& ComponentGUIDs();
 
+		// Returns nullptr if the component has no property with the name
+		static const ComponentProperty* FindProperty(const RegistrationInfo& aInfo, uint64_t aNameHash);
+
 	private:
+		// Points into ComponentGUIDs, which keeps its element addresses stable
+		static std::unordered_map<WireGUID, const RegistrationInfo*>& GUIDIndex();
+
 		static void ParseDefinition(const std::string& definitionData, RegistrationInfo& outInfo);
 	};
 
@@ -91,12 +137,51 @@ namespace Wire
 	public:
 		Serializer() = delete;
 
+		// Written in place of the name length when a component is keyed by its GUID instead of its name
+		static constexpr uint16_t GUIDEncodingTag = 0xFFFF;
+
+		// Like GUIDEncodingTag, followed by the component size and the schema the data was saved with
+		static constexpr uint16_t SchemaEncodingTag = 0xFFFE;
+
 		/*
 		* First 4 bytes: the entity ID
 		* Next 4 bytes: the component count
 		* The rest: The components and it's data
+		* Components are written with SchemaEncodingTag, files with name or GUID keyed components are still read
+		*
+		* Schema: layout hash (8 bytes), property count (4 bytes), per property: name hash (8 bytes), type (4 bytes), offset (4 bytes)
+		* Components whose saved layout hash matches the registered one are copied as is. Otherwise the registered
+		* properties are filled from the saved properties with the same name, numbers are converted between types
+		* and properties missing from the saved data are zeroed. Components that can not be migrated are skipped.
+		* Components with ComponentOps (not trivially copyable) can not be stored as bytes, they are neither saved nor loaded.
+		*
+		* Name or GUID keyed components from older files carry no size or schema. They are read with the registered size
+		* and never migrated, and reading stops at the first one that is not registered since its size is unknown.
 		*/
 		static void SerializeEntityToFile(EntityId aId, const Registry& aRegistry, const std::filesystem::path& aSceneFolder);
+		// Returns NullID if the file can not be read, is truncated or its entity id is already in use
 		static EntityId DeserializeEntityToRegistry(const std::filesystem::path& aPath, Registry& aRegistry);
+
+		/*
+		* Loads every .ent file in the folder. Files are read and decoded on the job system into per chunk
+		* staging buffers, which are then inserted into the registry in one pass on the calling thread.
+		* Truncated files and files whose entity id is already in use are skipped, the returned ids are the entities that were added.
+		*/
+		static std::vector<EntityId> DeserializeSceneFolder(const std::filesystem::path& aSceneFolder, Registry& aRegistry, JobSystem& jobSystem = JobSystem::GetDefault());
+
+		static constexpr uint32_t RegistryFileMagic = 0x47455257; // "WREG"
+		static constexpr uint32_t RegistryFileVersion = 2;
+
+		/*
+		* Writes the whole registry to a single file, laid out per pool
+		* Header: magic (4 bytes), version (4 bytes), entity count (4 bytes), the entity IDs, pool count (4 bytes)
+		* Per pool: GUID (16 bytes), component size (4 bytes), component count (4 bytes), the schema, the entity IDs, the packed component data
+		* Pools with a matching layout hash are loaded with a single bulk add, others are migrated like entity files.
+		* Version 1 files, which have no schema, are still read. Like entity files, pools with ComponentOps are skipped,
+		* the file keeps no record of them so they are silently missing after loading.
+		* Returns false without loading anything if one of the saved entity ids is already in use in aRegistry.
+		*/
+		static void SerializeRegistry(const Registry& aRegistry, const std::filesystem::path& aPath);
+		static bool DeserializeRegistry(const std::filesystem::path& aPath, Registry& aRegistry);
 	};
 }
\ No newline at end of file
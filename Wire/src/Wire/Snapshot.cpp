@@ -0,0 +1,529 @@
+#include "Snapshot.h"
+#include "Serialization.h"
+
+namespace Wire
+{
+	namespace Utility
+	{
+		// Changed byte runs closer than this are sent as one range
+		static constexpr size_t RangeMergeGap = 8;
+
+		struct DeltaWriter
+		{
+			std::vector<uint8_t>& data;
+
+			void Write(const void* aData, size_t aSize)
+			{
+				const size_t offset = data.size();
+				data.resize(offset + aSize);
+				memcpy(&data[offset], aData, aSize);
+			}
+
+			template<typename T>
+			void Write(const T& value)
+			{
+				Write(&value, sizeof(T));
+			}
+
+			// Leaves room for a value that is written later with WriteAt
+			template<typename T>
+			size_t Reserve()
+			{
+				const size_t offset = data.size();
+				data.resize(offset + sizeof(T));
+				return offset;
+			}
+
+			template<typename T>
+			void WriteAt(size_t aOffset, const T& value)
+			{
+				memcpy(&data[aOffset], &value, sizeof(T));
+			}
+		};
+
+		struct DeltaReader
+		{
+			std::span<const uint8_t> data;
+			size_t offset = 0;
+
+			bool Read(void* outData, size_t aSize)
+			{
+				if (offset + aSize > data.size())
+				{
+					return false;
+				}
+
+				memcpy(outData, &data[offset], aSize);
+				offset += aSize;
+				return true;
+			}
+
+			template<typename T>
+			bool Read(T& outValue)
+			{
+				return Read(&outValue, sizeof(T));
+			}
+
+			bool ReadSpan(size_t aSize, std::span<const uint8_t>& outSpan)
+			{
+				if (offset + aSize > data.size())
+				{
+					return false;
+				}
+
+				outSpan = data.subspan(offset, aSize);
+				offset += aSize;
+				return true;
+			}
+		};
+
+		// Column pools keep a component split across columns, so it is gathered into scratch first
+		static std::span<const uint8_t> ReadComponent(const ComponentPool& pool, EntityId id, std::vector<uint8_t>& scratch)
+		{
+			if (!pool.HasColumnLayout())
+			{
+				return pool.GetComponentBytes(id);
+			}
+
+			scratch.resize(pool.GetComponentSize());
+			pool.CopyComponentData(id, scratch);
+			return scratch;
+		}
+
+		// aOffset is where the compared bytes start inside the component
+		static uint32_t WriteChangedRanges(DeltaWriter& writer, std::span<const uint8_t> previous, std::span<const uint8_t> current, size_t aOffset)
+		{
+			if (memcmp(previous.data(), current.data(), current.size()) == 0)
+			{
+				return 0;
+			}
+
+			uint32_t rangeCount = 0;
+			size_t i = 0;
+
+			while (i < current.size())
+			{
+				if (previous[i] == current[i])
+				{
+					i++;
+					continue;
+				}
+
+				size_t lastDifference = i;
+				for (size_t end = i + 1; end < current.size() && end - lastDifference <= RangeMergeGap; end++)
+				{
+					if (previous[end] != current[end])
+					{
+						lastDifference = end;
+					}
+				}
+
+				const uint32_t rangeOffset = (uint32_t)(aOffset + i);
+				const uint32_t rangeSize = (uint32_t)(lastDifference + 1 - i);
+
+				writer.Write(rangeOffset);
+				writer.Write(rangeSize);
+				writer.Write(&current[i], rangeSize);
+
+				rangeCount++;
+				i = lastDifference + 1;
+			}
+
+			return rangeCount;
+		}
+
+		// Components with a known layout are compared per property, so padding never shows up as a change
+		static uint32_t WriteChangedComponent(DeltaWriter& writer, std::span<const uint8_t> previous, std::span<const uint8_t> current, const ComponentRegistry::RegistrationInfo& info)
+		{
+			if (!info.hasLayout)
+			{
+				return WriteChangedRanges(writer, previous, current, 0);
+			}
+
+			uint32_t rangeCount = 0;
+			for (const auto& property : info.properties)
+			{
+				rangeCount += WriteChangedRanges(writer, previous.subspan(property.offset, property.size), current.subspan(property.offset, property.size), property.offset);
+			}
+
+			return rangeCount;
+		}
+
+		/*
+		* Either pool may be null when it only exists in one of the snapshots, returns false if nothing changed.
+		* Pages the snapshots still share were not written in between, so only the copied pages are compared.
+		*/
+		static bool WritePoolDelta(DeltaWriter& writer, const WireGUID& guid, const ComponentPool* previousPool, const ComponentPool* currentPool, const Registry& current, uint64_t aSinceTick)
+		{
+			const size_t start = writer.data.size();
+			const ComponentRegistry::RegistrationInfo& info = ComponentRegistry::GetRegistryDataFromGUID(guid);
+
+			const uint32_t componentSize = currentPool ? currentPool->GetComponentSize() : previousPool->GetComponentSize();
+			std::vector<uint8_t> previousScratch;
+			std::vector<uint8_t> currentScratch;
+
+			writer.Write(guid);
+			writer.Write(componentSize);
+
+			// Components of destroyed entities are removed along with the entity
+			uint32_t removedCount = 0;
+			const size_t removedCountOffset = writer.Reserve<uint32_t>();
+
+			auto writeRemoved = [&](EntityId id)
+			{
+				if ((!currentPool || !currentPool->HasComponent(id)) && current.IsValid(id))
+				{
+					writer.Write(id);
+					removedCount++;
+				}
+			};
+
+			if (previousPool && currentPool)
+			{
+				previousPool->ForEachUnsharedEntity(*currentPool, writeRemoved);
+			}
+			else if (previousPool)
+			{
+				for (const EntityId id : previousPool->GetComponentView())
+				{
+					writeRemoved(id);
+				}
+			}
+
+			writer.WriteAt(removedCountOffset, removedCount);
+
+			uint32_t addedCount = 0;
+			const size_t addedCountOffset = writer.Reserve<uint32_t>();
+
+			auto writeAdded = [&](EntityId id)
+			{
+				if (!previousPool || !previousPool->HasComponent(id))
+				{
+					const std::span<const uint8_t> componentData = ReadComponent(*currentPool, id, currentScratch);
+
+					writer.Write(id);
+					writer.Write(componentData.data(), componentData.size());
+					addedCount++;
+				}
+			};
+
+			if (previousPool && currentPool)
+			{
+				currentPool->ForEachUnsharedEntity(*previousPool, writeAdded);
+			}
+			else if (currentPool)
+			{
+				for (const EntityId id : currentPool->GetComponentView())
+				{
+					writeAdded(id);
+				}
+			}
+
+			writer.WriteAt(addedCountOffset, addedCount);
+
+			uint32_t changedCount = 0;
+			const size_t changedCountOffset = writer.Reserve<uint32_t>();
+
+			if (previousPool && currentPool)
+			{
+				const std::span<const EntityId> entities = currentPool->GetComponentView();
+
+				for (size_t page = 0; page < currentPool->GetPageCount(); page++)
+				{
+					if (currentPool->SharesPage(*previousPool, page))
+					{
+						continue;
+					}
+
+					const size_t end = std::min(entities.size(), (page + 1) * ComponentPool::ComponentsPerPage);
+					for (size_t i = page * ComponentPool::ComponentsPerPage; i < end; i++)
+					{
+						const EntityId id = entities[i];
+
+						// Untouched since the previous snapshot, no need to compare
+						if (currentPool->IsTrackingChanges() && currentPool->GetVersion(i) < aSinceTick)
+						{
+							continue;
+						}
+
+						if (!previousPool->HasComponent(id))
+						{
+							continue;
+						}
+
+						const std::span<const uint8_t> previousData = ReadComponent(*previousPool, id, previousScratch);
+						const std::span<const uint8_t> currentData = ReadComponent(*currentPool, id, currentScratch);
+
+						const size_t componentStart = writer.data.size();
+						writer.Write(id);
+						const size_t rangeCountOffset = writer.Reserve<uint32_t>();
+
+						const uint32_t rangeCount = WriteChangedComponent(writer, previousData, currentData, info);
+						if (rangeCount == 0)
+						{
+							writer.data.resize(componentStart);
+							continue;
+						}
+
+						writer.WriteAt(rangeCountOffset, rangeCount);
+						changedCount++;
+					}
+				}
+			}
+
+			writer.WriteAt(changedCountOffset, changedCount);
+
+			if (removedCount == 0 && addedCount == 0 && changedCount == 0)
+			{
+				writer.data.resize(start);
+				return false;
+			}
+
+			return true;
+		}
+	}
+
+	Snapshot::Snapshot(const Registry& aRegistry)
+		: m_registry(aRegistry.Clone()), m_tick(aRegistry.GetCurrentTick())
+	{
+	}
+
+	std::vector<uint8_t> DeltaSerializer::CreateDelta(const Snapshot& aPrevious, const Snapshot& aCurrent)
+	{
+		const Registry& previous = aPrevious.GetRegistry();
+		const Registry& current = aCurrent.GetRegistry();
+
+		std::vector<uint8_t> data;
+		Utility::DeltaWriter writer{ data };
+
+		writer.Write(DeltaMagic);
+
+		uint32_t destroyedCount = 0;
+		const size_t destroyedCountOffset = writer.Reserve<uint32_t>();
+
+		// Only slot pages written since the previous snapshot can hold created or destroyed entities
+		previous.ForEachUnsharedEntity(current, [&](EntityId id)
+			{
+				if (!current.IsValid(id))
+				{
+					writer.Write(id);
+					destroyedCount++;
+				}
+			});
+
+		writer.WriteAt(destroyedCountOffset, destroyedCount);
+
+		uint32_t createdCount = 0;
+		const size_t createdCountOffset = writer.Reserve<uint32_t>();
+
+		current.ForEachUnsharedEntity(previous, [&](EntityId id)
+			{
+				if (!previous.IsValid(id))
+				{
+					writer.Write(id);
+					createdCount++;
+				}
+			});
+
+		writer.WriteAt(createdCountOffset, createdCount);
+
+		uint32_t poolCount = 0;
+		const size_t poolCountOffset = writer.Reserve<uint32_t>();
+
+		// Components with ops are not sent, their bytes are not objects
+		for (const auto& [guid, pool] : current.GetPools())
+		{
+			if (pool.GetOps())
+			{
+				continue;
+			}
+
+			auto it = previous.GetPools().find(guid);
+			const ComponentPool* previousPool = (it != previous.GetPools().end()) ? &it->second : nullptr;
+
+			if (Utility::WritePoolDelta(writer, guid, previousPool, &pool, current, aPrevious.GetTick()))
+			{
+				poolCount++;
+			}
+		}
+
+		for (const auto& [guid, pool] : previous.GetPools())
+		{
+			if (!pool.GetOps() && current.GetPools().find(guid) == current.GetPools().end())
+			{
+				if (Utility::WritePoolDelta(writer, guid, &pool, nullptr, current, aPrevious.GetTick()))
+				{
+					poolCount++;
+				}
+			}
+		}
+
+		writer.WriteAt(poolCountOffset, poolCount);
+
+		return data;
+	}
+
+	bool DeltaSerializer::ApplyDelta(std::span<const uint8_t> aDelta, Registry& aRegistry)
+	{
+		Utility::DeltaReader reader{ aDelta };
+
+		uint32_t magic = 0;
+		if (!reader.Read(magic) || magic != DeltaMagic)
+		{
+			return false;
+		}
+
+		uint32_t destroyedCount = 0;
+		if (!reader.Read(destroyedCount))
+		{
+			return false;
+		}
+
+		for (uint32_t i = 0; i < destroyedCount; i++)
+		{
+			EntityId id = NullID;
+			if (!reader.Read(id))
+			{
+				return false;
+			}
+
+			if (aRegistry.IsValid(id))
+			{
+				aRegistry.RemoveEntity(id);
+			}
+		}
+
+		uint32_t createdCount = 0;
+		if (!reader.Read(createdCount))
+		{
+			return false;
+		}
+
+		for (uint32_t i = 0; i < createdCount; i++)
+		{
+			EntityId id = NullID;
+			if (!reader.Read(id) || aRegistry.AddEntity(id) == NullID)
+			{
+				return false;
+			}
+		}
+
+		uint32_t poolCount = 0;
+		if (!reader.Read(poolCount))
+		{
+			return false;
+		}
+
+		for (uint32_t pool = 0; pool < poolCount; pool++)
+		{
+			WireGUID guid;
+			uint32_t componentSize = 0;
+			uint32_t removedCount = 0;
+
+			if (!reader.Read(guid) || !reader.Read(componentSize) || !reader.Read(removedCount))
+			{
+				return false;
+			}
+
+			// Deltas never contain components with ops, such data can not be written as bytes
+			const auto existingPool = aRegistry.GetPools().find(guid);
+			if (ComponentRegistry::GetRegistryDataFromGUID(guid).ops || (existingPool != aRegistry.GetPools().end() && existingPool->second.GetOps()))
+			{
+				return false;
+			}
+
+			if (existingPool != aRegistry.GetPools().end() && existingPool->second.GetComponentSize() != componentSize)
+			{
+				return false;
+			}
+
+			for (uint32_t i = 0; i < removedCount; i++)
+			{
+				EntityId id = NullID;
+				if (!reader.Read(id))
+				{
+					return false;
+				}
+
+				if (aRegistry.HasComponent(guid, id))
+				{
+					aRegistry.RemoveComponent(guid, id);
+				}
+			}
+
+			uint32_t addedCount = 0;
+			if (!reader.Read(addedCount))
+			{
+				return false;
+			}
+
+			for (uint32_t i = 0; i < addedCount; i++)
+			{
+				EntityId id = NullID;
+				std::span<const uint8_t> componentData;
+
+				if (!reader.Read(id) || !reader.ReadSpan(componentSize, componentData))
+				{
+					return false;
+				}
+
+				aRegistry.AddComponent(componentData, guid, id);
+			}
+
+			uint32_t changedCount = 0;
+			if (!reader.Read(changedCount))
+			{
+				return false;
+			}
+
+			// Column pools are patched on a gathered copy that is scattered back afterwards
+			const auto poolIt = aRegistry.GetPools().find(guid);
+			const bool columnLayout = poolIt != aRegistry.GetPools().end() && poolIt->second.HasColumnLayout();
+			std::vector<uint8_t> scratch;
+
+			for (uint32_t i = 0; i < changedCount; i++)
+			{
+				EntityId id = NullID;
+				uint32_t rangeCount = 0;
+
+				if (!reader.Read(id) || !reader.Read(rangeCount) || !aRegistry.HasComponent(guid, id))
+				{
+					return false;
+				}
+
+				std::span<uint8_t> componentData;
+				if (columnLayout)
+				{
+					scratch.resize(componentSize);
+					poolIt->second.CopyComponentData(id, scratch);
+					componentData = scratch;
+				}
+				else
+				{
+					componentData = aRegistry.GetComponentBytes(guid, id);
+				}
+
+				for (uint32_t range = 0; range < rangeCount; range++)
+				{
+					uint32_t rangeOffset = 0;
+					uint32_t rangeSize = 0;
+					std::span<const uint8_t> rangeData;
+
+					if (!reader.Read(rangeOffset) || !reader.Read(rangeSize) || rangeOffset + rangeSize > componentData.size() || !reader.ReadSpan(rangeSize, rangeData))
+					{
+						return false;
+					}
+
+					memcpy(&componentData[rangeOffset], rangeData.data(), rangeSize);
+				}
+
+				if (columnLayout)
+				{
+					aRegistry.SetComponentData(componentData, guid, id);
+				}
+			}
+		}
+
+		return true;
+	}
+}
\ No newline at end of file
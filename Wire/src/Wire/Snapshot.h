@@ -0,0 +1,50 @@
+#pragma once
+
+#include "Registry.h"
+
+#include <span>
+#include <vector>
+
+namespace Wire
+{
+	// A frozen copy of a registry's state at the tick it was captured, shares the registry's pages until they are modified
+	class Snapshot
+	{
+	public:
+		Snapshot() = default;
+		explicit Snapshot(const Registry& aRegistry);
+
+		inline const Registry& GetRegistry() const { return m_registry; }
+		inline const uint64_t GetTick() const { return m_tick; }
+
+	private:
+		Registry m_registry;
+		uint64_t m_tick = 0;
+	};
+
+	class DeltaSerializer
+	{
+	public:
+		DeltaSerializer() = delete;
+
+		static constexpr uint32_t DeltaMagic = 0x544C4457; // "WDLT"
+
+		/*
+		* Encodes what changed between two snapshots, the size of the result follows the amount of changes.
+		* Header: magic (4 bytes), destroyed entity count (4 bytes) and IDs, created entity count (4 bytes) and IDs, pool count (4 bytes)
+		* Per pool: GUID (16 bytes), component size (4 bytes),
+		*	removed count (4 bytes) and IDs,
+		*	added count (4 bytes) and per component the ID followed by the component data,
+		*	changed count (4 bytes) and per component the ID, range count (4 bytes) and per range the offset (4 bytes), size (4 bytes) and bytes
+		* Pages the two snapshots still share were not written in between and are skipped, so a delta between snapshots
+		* of the same registry costs time in the number of written pages rather than the size of the world.
+		* Components of pools that track changes are only compared if they were stamped after the previous snapshot,
+		* components with a parsed layout are compared per property so padding bytes are never sent.
+		* Pools with ComponentOps are not part of the delta, applying a delta that contains one fails.
+		*/
+		static std::vector<uint8_t> CreateDelta(const Snapshot& aPrevious, const Snapshot& aCurrent);
+
+		// Applies a delta to a registry that matches the delta's previous snapshot
+		static bool ApplyDelta(std::span<const uint8_t> aDelta, Registry& aRegistry);
+	};
+}
\ No newline at end of file
@@ -0,0 +1,161 @@
+#include "Stats.h"
+#include "Serialization.h"
+
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace Wire
+{
+	namespace Utility
+	{
+		struct ScopeEvent
+		{
+			const char* name = nullptr;
+			Trace::Clock::time_point begin;
+			Trace::Clock::time_point end;
+			uint64_t count = 0;
+			size_t thread = 0;
+		};
+
+		struct CounterEvent
+		{
+			std::string name;
+			Trace::Clock::time_point time;
+			size_t componentCount = 0;
+			size_t bytesUsed = 0;
+			size_t bytesReserved = 0;
+		};
+
+		struct TraceData
+		{
+			std::mutex mutex;
+			std::atomic<bool> recording = false;
+			Trace::Clock::time_point start = Trace::Clock::now();
+
+			std::vector<ScopeEvent> scopes;
+			std::vector<CounterEvent> counters;
+		};
+
+		static TraceData& GetTraceData()
+		{
+			static TraceData data;
+			return data;
+		}
+
+		static uint64_t ToMicroseconds(Trace::Clock::time_point aTime)
+		{
+			return (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(aTime - GetTraceData().start).count();
+		}
+	}
+
+	void Trace::Start()
+	{
+		Utility::GetTraceData().recording = true;
+	}
+
+	void Trace::Stop()
+	{
+		Utility::GetTraceData().recording = false;
+	}
+
+	bool Trace::IsRecording()
+	{
+		return Utility::GetTraceData().recording;
+	}
+
+	void Trace::RecordScope(const char* aName, Clock::time_point aBegin, Clock::time_point aEnd, uint64_t aCount)
+	{
+		Utility::TraceData& data = Utility::GetTraceData();
+		if (!data.recording)
+		{
+			return;
+		}
+
+		const size_t thread = std::hash<std::thread::id>()(std::this_thread::get_id());
+
+		std::lock_guard lock(data.mutex);
+		data.scopes.emplace_back(Utility::ScopeEvent{ aName, aBegin, aEnd, aCount, thread });
+	}
+
+	void Trace::RecordStats(const RegistryStats& aStats)
+	{
+		Utility::TraceData& data = Utility::GetTraceData();
+		if (!data.recording)
+		{
+			return;
+		}
+
+		const Clock::time_point now = Clock::now();
+
+		std::lock_guard lock(data.mutex);
+		data.counters.emplace_back(Utility::CounterEvent{ "Registry", now, aStats.entityCount, aStats.bytesUsed, aStats.bytesReserved });
+
+		for (const PoolStats& pool : aStats.pools)
+		{
+			data.counters.emplace_back(Utility::CounterEvent{ ComponentRegistry::GetNameFromGUID(pool.guid), now, pool.componentCount, pool.bytesUsed, pool.bytesReserved });
+		}
+	}
+
+	bool Trace::WriteChromeTrace(const std::filesystem::path& aPath)
+	{
+		std::ofstream file(aPath);
+		if (!file.is_open())
+		{
+			return false;
+		}
+
+		Utility::TraceData& data = Utility::GetTraceData();
+		std::lock_guard lock(data.mutex);
+
+		// Names are identifiers or registered type names, so they need no escaping
+		file << "{\"traceEvents\":[";
+
+		bool first = true;
+		for (const Utility::ScopeEvent& scope : data.scopes)
+		{
+			file << (first ? "\n" : ",\n");
+			file << "{\"name\":\"" << scope.name << "\",\"ph\":\"X\",\"pid\":0,\"tid\":" << scope.thread
+				<< ",\"ts\":" << Utility::ToMicroseconds(scope.begin) << ",\"dur\":" << Utility::ToMicroseconds(scope.end) - Utility::ToMicroseconds(scope.begin)
+				<< ",\"args\":{\"count\":" << scope.count << "}}";
+			first = false;
+		}
+
+		for (const Utility::CounterEvent& counter : data.counters)
+		{
+			file << (first ? "\n" : ",\n");
+			file << "{\"name\":\"" << counter.name << "\",\"ph\":\"C\",\"pid\":0,\"ts\":" << Utility::ToMicroseconds(counter.time)
+				<< ",\"args\":{\"components\":" << counter.componentCount << ",\"bytesUsed\":" << counter.bytesUsed << ",\"bytesReserved\":" << counter.bytesReserved << "}}";
+			first = false;
+		}
+
+		file << "\n]}\n";
+		return file.good();
+	}
+
+	void Trace::Clear()
+	{
+		Utility::TraceData& data = Utility::GetTraceData();
+		std::lock_guard lock(data.mutex);
+
+		data.scopes.clear();
+		data.counters.clear();
+	}
+
+	TraceScope::TraceScope(const char* aName, uint64_t aCount, StatCounter* aTotalNanoseconds)
+		: m_name(aName), m_count(aCount), m_totalNanoseconds(aTotalNanoseconds), m_begin(Trace::Clock::now())
+	{
+	}
+
+	TraceScope::~TraceScope()
+	{
+		const Trace::Clock::time_point end = Trace::Clock::now();
+		if (m_totalNanoseconds)
+		{
+			m_totalNanoseconds->Add((uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(end - m_begin).count());
+		}
+
+		Trace::RecordScope(m_name, m_begin, end, m_count);
+	}
+}
\ No newline at end of file
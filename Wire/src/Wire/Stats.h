@@ -0,0 +1,140 @@
+#pragma once
+
+#include "WireGUID.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+/*
+* Define WIRE_ENABLE_STATS to count pool and registry operations and to time ForEach calls.
+* Without it the counters are not stored and the macros below compile to nothing, the memory and
+* occupancy figures of the stats are computed from the containers when queried and are always available.
+*/
+#ifdef WIRE_ENABLE_STATS
+	#define WIRE_STATS(expression) expression
+	#define WIRE_TRACE_SCOPE(name, count, totalNanoseconds) ::Wire::TraceScope wireTraceScope(name, count, totalNanoseconds)
+#else
+	#define WIRE_STATS(expression)
+	#define WIRE_TRACE_SCOPE(name, count, totalNanoseconds)
+#endif
+
+namespace Wire
+{
+	// Relaxed atomic so that parallel iteration can count, copyable so that pools and registries stay copyable
+	class StatCounter
+	{
+	public:
+		StatCounter() = default;
+		StatCounter(const StatCounter& counter) : m_value(counter.Get()) {}
+
+		StatCounter& operator=(const StatCounter& counter) { m_value.store(counter.Get(), std::memory_order_relaxed); return *this; }
+
+		inline void Add(uint64_t aAmount = 1) { m_value.fetch_add(aAmount, std::memory_order_relaxed); }
+		inline uint64_t Get() const { return m_value.load(std::memory_order_relaxed); }
+
+	private:
+		std::atomic<uint64_t> m_value = 0;
+	};
+
+	struct PoolCounters
+	{
+		StatCounter adds;
+		StatCounter removes;
+		StatCounter gets;
+		StatCounter pageAllocations;
+		StatCounter pageCopies; // Copy on write of pages shared with a clone
+		StatCounter sparsePageAllocations;
+		StatCounter denseReallocations;
+	};
+
+	struct RegistryCounters
+	{
+		StatCounter creates;
+		StatCounter destroys;
+		StatCounter forEachCalls;
+		StatCounter forEachNanoseconds;
+	};
+
+	// The counts are zero unless WIRE_ENABLE_STATS is defined
+	struct PoolStats
+	{
+		WireGUID guid;
+		size_t componentSize = 0;
+		size_t componentCount = 0;
+		size_t pageCount = 0;
+		size_t sharedPageCount = 0; // Pages still shared with a clone
+
+		size_t bytesReserved = 0;
+		size_t bytesUsed = 0;
+
+		uint64_t addCount = 0;
+		uint64_t removeCount = 0;
+		uint64_t getCount = 0;
+		uint64_t pageAllocations = 0;
+		uint64_t pageCopies = 0;
+		uint64_t sparsePageAllocations = 0;
+		uint64_t denseReallocations = 0;
+	};
+
+	struct RegistryStats
+	{
+		size_t entityCount = 0;
+		size_t entitySlotCount = 0;
+		size_t freeSlotCount = 0;
+
+		// Includes the pools
+		size_t bytesReserved = 0;
+		size_t bytesUsed = 0;
+
+		uint64_t createCount = 0;
+		uint64_t destroyCount = 0;
+		uint64_t forEachCount = 0;
+		double forEachMilliseconds = 0.0;
+
+		std::vector<PoolStats> pools;
+	};
+
+	/*
+	* Collects timed scopes and stats snapshots between Start and Stop, WriteChromeTrace writes them as a
+	* Chrome trace (chrome://tracing or Perfetto). Scopes are only recorded with WIRE_ENABLE_STATS defined.
+	*/
+	class Trace
+	{
+	public:
+		using Clock = std::chrono::steady_clock;
+
+		Trace() = delete;
+
+		static void Start();
+		static void Stop();
+		static bool IsRecording();
+
+		static void RecordScope(const char* aName, Clock::time_point aBegin, Clock::time_point aEnd, uint64_t aCount);
+
+		// Adds counter tracks with the memory and component count of every pool
+		static void RecordStats(const RegistryStats& aStats);
+
+		static bool WriteChromeTrace(const std::filesystem::path& aPath);
+		static void Clear();
+	};
+
+	// Records a scope while the trace is recording and adds its duration to aTotalNanoseconds
+	class TraceScope
+	{
+	public:
+		TraceScope(const char* aName, uint64_t aCount, StatCounter* aTotalNanoseconds = nullptr);
+		~TraceScope();
+
+		TraceScope(const TraceScope&) = delete;
+		TraceScope& operator=(const TraceScope&) = delete;
+
+	private:
+		const char* m_name;
+		uint64_t m_count;
+		StatCounter* m_totalNanoseconds;
+		Trace::Clock::time_point m_begin;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace Wire
+{
+	/*
+	* Hands out a dense index per component type the first time the type is used.
+	* Indices are only valid for the running process, serialized data uses the component GUID.
+	*/
+	class TypeIndex
+	{
+	public:
+		TypeIndex() = delete;
+
+		template<typename T>
+		static uint32_t Get();
+
+	private:
+		inline static std::atomic<uint32_t> s_nextIndex = 0;
+	};
+
+	template<typename T>
+	inline uint32_t TypeIndex::Get()
+	{
+		static const uint32_t index = s_nextIndex++;
+		return index;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,226 @@
+#pragma once
+
+#include "Entity.h"
+#include "ComponentPool.hpp"
+#include "OwningGroup.h"
+#include "JobSystem.h"
+
+#include <array>
+#include <utility>
+
+namespace Wire
+{
+	/*
+	* A view over all entities that have every component in T.
+	* Pool pointers are resolved once on creation and iteration is driven by the smallest pool,
+	* so the cost scales with the number of candidates rather than the total entity count.
+	* If the pools are owned by a group of exactly these types, the packed group range is walked in lock step instead.
+	* Pools with a column layout can not be viewed, creating the view throws std::logic_error.
+	*/
+	template<typename ... T>
+	class View
+	{
+	public:
+		View() = default;
+		View(const std::array<ComponentPool*, sizeof...(T)>& pools);
+
+		template<typename F>
+		void ForEach(F&& func) const;
+
+		/*
+		* Splits the dense range of the driving pool into chunks of aChunkSize and runs them on the job system.
+		* func is called concurrently and must not add or remove entities or components.
+		*/
+		template<typename F>
+		void ParallelForEach(F&& func, JobSystem& jobSystem, size_t aChunkSize = 1024) const;
+
+		bool Contains(EntityId aId) const;
+
+		// Upper bound of the number of entities the view will visit
+		size_t SizeHint() const;
+
+	private:
+		template<typename F, size_t ... I>
+		void ForEachImpl(F&& func, std::index_sequence<I...>) const;
+
+		template<size_t ... I>
+		void MakePoolsUnique(std::index_sequence<I...>) const;
+
+		template<typename F, size_t ... I>
+		void ForEachInRange(F& func, size_t aBegin, size_t aEnd, std::index_sequence<I...>) const;
+
+		// Number of dense entries to visit, m_drivingPool's size or the group size
+		size_t GetIterationCount() const;
+
+		std::array<ComponentPool*, sizeof...(T)> m_pools{};
+		ComponentPool* m_drivingPool = nullptr;
+		const OwningGroup* m_group = nullptr;
+	};
+
+	template<typename ...T>
+	inline View<T...>::View(const std::array<ComponentPool*, sizeof...(T)>& pools)
+		: m_pools(pools)
+	{
+		for (ComponentPool* pool : m_pools)
+		{
+			// A missing pool means no entity can match
+			if (!pool)
+			{
+				m_drivingPool = nullptr;
+				return;
+			}
+
+			pool->CheckComponentLayout();
+
+			if (!m_drivingPool || pool->GetComponentView().size() < m_drivingPool->GetComponentView().size())
+			{
+				m_drivingPool = pool;
+			}
+		}
+
+		const OwningGroup* group = m_pools.front()->GetGroup();
+		if (group && group->GetPools().size() == sizeof...(T))
+		{
+			bool ownsAll = true;
+			for (const ComponentPool* pool : m_pools)
+			{
+				ownsAll &= pool->GetGroup() == group;
+			}
+
+			m_group = ownsAll ? group : nullptr;
+		}
+	}
+
+	template<typename ...T>
+	template<typename F>
+	inline void View<T...>::ForEach(F&& func) const
+	{
+		if (m_drivingPool)
+		{
+			ForEachImpl(std::forward<F>(func), std::index_sequence_for<T...>{});
+		}
+	}
+
+	template<typename ...T>
+	template<typename F>
+	inline void View<T...>::ParallelForEach(F&& func, JobSystem& jobSystem, size_t aChunkSize) const
+	{
+		if (!m_drivingPool)
+		{
+			return;
+		}
+
+		// Pages shared with a clone would otherwise be copied from several threads at once
+		MakePoolsUnique(std::index_sequence_for<T...>{});
+
+		jobSystem.ParallelFor(GetIterationCount(), aChunkSize, [this, &func](size_t begin, size_t end)
+			{
+				ForEachInRange(func, begin, end, std::index_sequence_for<T...>{});
+			});
+	}
+
+	template<typename ...T>
+	inline bool View<T...>::Contains(EntityId aId) const
+	{
+		if (!m_drivingPool)
+		{
+			return false;
+		}
+
+		for (const ComponentPool* pool : m_pools)
+		{
+			if (!pool->HasComponent(aId))
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	template<typename ...T>
+	inline size_t View<T...>::SizeHint() const
+	{
+		return m_drivingPool ? GetIterationCount() : 0;
+	}
+
+	template<typename ...T>
+	inline size_t View<T...>::GetIterationCount() const
+	{
+		return m_group ? m_group->GetSize() : m_drivingPool->GetComponentView().size();
+	}
+
+	template<typename ...T>
+	template<typename F, size_t ...I>
+	inline void View<T...>::ForEachImpl(F&& func, std::index_sequence<I...>) const
+	{
+		if (m_group)
+		{
+			const std::span<const EntityId> entities = m_pools.front()->GetComponentView();
+
+			// Every owned pool stores the group's entities at the same dense indices
+			for (size_t i = m_group->GetSize(); i > 0; i--)
+			{
+				func(entities[i - 1], m_pools[I]->template GetComponentAt<T>((uint32_t)i - 1)...);
+			}
+
+			return;
+		}
+
+		const std::span<const EntityId> entities = m_drivingPool->GetComponentView();
+
+		// Iterate backwards so that removing the current entity's components does not skip any entity
+		for (size_t i = entities.size(); i > 0; i--)
+		{
+			const EntityId id = entities[i - 1];
+			const std::array<uint32_t, sizeof...(T)> denseIndices{ m_pools[I]->GetDenseIndex(id)... };
+
+			if (((denseIndices[I] != ComponentPool::NullIndex) && ...))
+			{
+				func(id, m_pools[I]->template GetComponentAt<T>(denseIndices[I])...);
+			}
+		}
+	}
+
+	template<typename ...T>
+	template<typename F, size_t ...I>
+	inline void View<T...>::ForEachInRange(F& func, size_t aBegin, size_t aEnd, std::index_sequence<I...>) const
+	{
+		if (m_group)
+		{
+			const std::span<const EntityId> entities = m_pools.front()->GetComponentView();
+			for (size_t i = aBegin; i < aEnd; i++)
+			{
+				func(entities[i], m_pools[I]->template GetComponentAt<T>((uint32_t)i)...);
+			}
+
+			return;
+		}
+
+		const std::span<const EntityId> entities = m_drivingPool->GetComponentView();
+
+		for (size_t i = aBegin; i < aEnd; i++)
+		{
+			const EntityId id = entities[i];
+			const std::array<uint32_t, sizeof...(T)> denseIndices{ m_pools[I]->GetDenseIndex(id)... };
+
+			if (((denseIndices[I] != ComponentPool::NullIndex) && ...))
+			{
+				func(id, m_pools[I]->template GetComponentAt<T>(denseIndices[I])...);
+			}
+		}
+	}
+
+	template<typename ...T>
+	template<size_t ...I>
+	inline void View<T...>::MakePoolsUnique(std::index_sequence<I...>) const
+	{
+		([this]()
+			{
+				if constexpr (!std::is_const_v<T>)
+				{
+					m_pools[I]->MakeUnique();
+				}
+			}(), ...);
+	}
+}
\ No newline at end of file
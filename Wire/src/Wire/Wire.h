@@ -2,4 +2,14 @@
 
 #include "Registry.h"
 #include "Serialization.h"
-#include "Entity.h"
\ No newline at end of file
+#include "Entity.h"
+#include "View.h"
+#include "Query.h"
+#include "JobSystem.h"
+#include "TypeIndex.h"
+#include "Snapshot.h"
+#include "CommandBuffer.h"
+#include "OwningGroup.h"
+#include "ComponentColumn.h"
+#include "Stats.h"
+#include "Arena.h"
\ No newline at end of file
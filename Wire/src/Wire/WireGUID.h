@@ -1,7 +1,7 @@
 #pragma once
 
 #include <cstdint>
-#include <xhash>
+#include <functional>
 
 // Based on CryEngines CryGUID
 struct WireGUID
@@ -11,10 +11,8 @@ struct WireGUID
 	{
 	}
 
-	constexpr WireGUID(const WireGUID& rhs)
-		: hiPart(rhs.hiPart), loPart(rhs.loPart)
-	{
-	}
+	// Defaulted so the GUID stays trivially copyable and can be read from raw bytes
+	constexpr WireGUID(const WireGUID& rhs) = default;
 
 	constexpr WireGUID(const uint64_t& hi, const uint64_t& lo)
 		: hiPart(hi), loPart(lo)
@@ -17,4 +17,6 @@ workspace "Wire"
 outputdir = "%{cfg.buildcfg}-%{cfg.system}-%{cfg.architecture}"
 
 include "Test"
+
+include "Benchmark"
 include "Wire"
\ No newline at end of file